@@ -1,6 +1,9 @@
 #include <ecsimd/jacobian_curve_point.h>
 #include <ecsimd/curve_group.h>
 #include <ecsimd/curve_nist_p256.h>
+#include <ecsimd/mgry_r52.h>
+#include <ecsimd/mgry_r29.h>
+#include <ecsimd/mgry_u32x64.h>
 #include <ecsimd/serialization.h>
 #include <ecsimd/literals.h>
 
@@ -8,6 +11,7 @@
 
 #include <cstdint>
 #include <random>
+#include <vector>
 
 using namespace ecsimd;
 using namespace ecsimd::literals;
@@ -20,10 +24,12 @@ auto wide_bignum_set1(std::array<uint8_t, sizeof(typename WBN::value_type)> cons
   return WBN{BN};
 }
 
+template <class Cardinal,
+          template <class, class> class MgryRepr = wide_field_bignum>
 void bench_p256(benchmark::State& S) {
   using Curve = curve_nist_p256;
-  using CurveGroup = curve_group<Curve>;
-  using WBN = curve_wide_bn_t<Curve>;
+  using CurveGroup = curve_group<Curve, Cardinal, MgryRepr>;
+  using WBN = curve_wide_bn_t<Curve, Cardinal>;
 
   const auto WJG = CurveGroup::WJG();
   const auto x = wide_bignum_set1<WBN>("0a891cecc2bf13b0aca744434a9c9f4bd7bf5c8ed86e2f76e7df72bad813bd80"_hex);
@@ -33,10 +39,44 @@ void bench_p256(benchmark::State& S) {
     benchmark::DoNotOptimize(WMP.to_affine());
   }
 }
+template <class Cardinal,
+          template <class, class> class MgryRepr = wide_field_bignum>
+void bench_p256_vartime(benchmark::State& S) {
+  using Curve = curve_nist_p256;
+  using CurveGroup = curve_group<Curve, Cardinal, MgryRepr>;
+  using WBN = curve_wide_bn_t<Curve, Cardinal>;
+
+  const auto WJG = CurveGroup::WJG();
+  const auto x = wide_bignum_set1<WBN>("0a891cecc2bf13b0aca744434a9c9f4bd7bf5c8ed86e2f76e7df72bad813bd80"_hex);
+
+  for (auto _: S) {
+    const auto WMP = CurveGroup::scalar_mult_vartime(x, WJG);
+    benchmark::DoNotOptimize(WMP.to_affine());
+  }
+}
+
+// x*G with the precomputed table (computed before the timed loop)
+template <class Cardinal,
+          template <class, class> class MgryRepr = wide_field_bignum>
+void bench_p256_base(benchmark::State& S) {
+  using Curve = curve_nist_p256;
+  using CurveGroup = curve_group<Curve, Cardinal, MgryRepr>;
+  using WBN = curve_wide_bn_t<Curve, Cardinal>;
+
+  CurveGroup::base_table();
+  const auto x = wide_bignum_set1<WBN>("0a891cecc2bf13b0aca744434a9c9f4bd7bf5c8ed86e2f76e7df72bad813bd80"_hex);
+
+  for (auto _: S) {
+    const auto WMP = CurveGroup::scalar_mult_base(x);
+    benchmark::DoNotOptimize(WMP.to_affine());
+  }
+}
+
+template <class Cardinal>
 void bench_p256_1s(benchmark::State& S) {
   using Curve = curve_nist_p256;
-  using CurveGroup = curve_group<Curve>;
-  using WBN = curve_wide_bn_t<Curve>;
+  using CurveGroup = curve_group<Curve, Cardinal>;
+  using WBN = curve_wide_bn_t<Curve, Cardinal>;
 
   const auto WJG = CurveGroup::WJG();
   const auto x = bn_from_bytes_BE<typename WBN::value_type>("0a891cecc2bf13b0aca744434a9c9f4bd7bf5c8ed86e2f76e7df72bad813bd80"_hex);
@@ -47,12 +87,62 @@ void bench_p256_1s(benchmark::State& S) {
   }
 }
 
+// Converts S.range(0) jacobian points to affine, one by one or with a
+// single batched inversion
+template <class Cardinal, bool Batch>
+void bench_p256_to_affine(benchmark::State& S) {
+  using Curve = curve_nist_p256;
+  using CurveGroup = curve_group<Curve, Cardinal>;
+  using WJCP = typename CurveGroup::WJCP;
+  using WCP = typename CurveGroup::WCP;
+
+  std::vector<WJCP> pts(S.range(0));
+  auto P = CurveGroup::WJG();
+  for (auto& pt: pts) {
+    pt = CurveGroup::DBLU(P);
+  }
+  std::vector<WCP> out(pts.size());
+
+  for (auto _: S) {
+    if constexpr (Batch) {
+      WJCP::batch_to_affine(pts, out);
+    }
+    else {
+      for (size_t i = 0; i < pts.size(); ++i) {
+        out[i] = pts[i].to_affine();
+      }
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+}
+
 } // anonymous
 
 int main(int argc, char** argv)
 {
-  benchmark::RegisterBenchmark("scalar_mult_p256_x4", bench_p256)->Unit(benchmark::kMicrosecond);
-  benchmark::RegisterBenchmark("scalar_mult_p256_1s_x4", bench_p256_1s)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_p256_x2", bench_p256<eve::fixed<2>>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_p256_x4", bench_p256<eve::fixed<4>>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_p256_x8", bench_p256<eve::fixed<8>>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_p256_mgry_x4", bench_p256<eve::fixed<4>, wide_mgry_bignum>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_p256_mgry_u32x64_x4", bench_p256<eve::fixed<4>, wide_mgry_u32x64>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_p256_r29_x4", bench_p256<eve::fixed<4>, wide_mgry_r29>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_p256_r52_x4", bench_p256<eve::fixed<4>, wide_mgry_r52>)->Unit(benchmark::kMicrosecond);
+#ifdef __AVX512F__
+  benchmark::RegisterBenchmark("scalar_mult_p256_r52_x8", bench_p256<eve::fixed<8>, wide_mgry_r52>)->Unit(benchmark::kMicrosecond);
+#endif
+  benchmark::RegisterBenchmark("scalar_mult_vartime_p256_x4", bench_p256_vartime<eve::fixed<4>>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_vartime_p256_x8", bench_p256_vartime<eve::fixed<8>>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_vartime_p256_mgry_x4", bench_p256_vartime<eve::fixed<4>, wide_mgry_bignum>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_vartime_p256_r52_x4", bench_p256_vartime<eve::fixed<4>, wide_mgry_r52>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_base_p256_x4", bench_p256_base<eve::fixed<4>>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_base_p256_x8", bench_p256_base<eve::fixed<8>>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_base_p256_mgry_x4", bench_p256_base<eve::fixed<4>, wide_mgry_bignum>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_base_p256_r52_x4", bench_p256_base<eve::fixed<4>, wide_mgry_r52>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_p256_1s_x2", bench_p256_1s<eve::fixed<2>>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_p256_1s_x4", bench_p256_1s<eve::fixed<4>>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("scalar_mult_p256_1s_x8", bench_p256_1s<eve::fixed<8>>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("to_affine_p256_x4", bench_p256_to_affine<eve::fixed<4>, false>)->Arg(64)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("batch_to_affine_p256_x4", bench_p256_to_affine<eve::fixed<4>, true>)->Arg(64)->Unit(benchmark::kMicrosecond);
 
   benchmark::Initialize(&argc, argv);
   benchmark::RunSpecifiedBenchmarks();
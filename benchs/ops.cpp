@@ -4,6 +4,18 @@
 #include <ecsimd/mgry_mul.h>
 #include <ecsimd/mgry.h>
 #include <ecsimd/mgry_ops.h>
+#include <ecsimd/mgry_r52.h>
+#include <ecsimd/mgry_r29.h>
+#include <ecsimd/mgry_u32x64.h>
+#include <ecsimd/special_form.h>
+#include <ecsimd/barrett.h>
+#include <ecsimd/mul_small.h>
+#include <ecsimd/sum_of_products.h>
+#include <ecsimd/gfp.h>
+#include <ecsimd/gfn.h>
+#include <ecsimd/mgry_context.h>
+#include <ecsimd/karatsuba.h>
+#include <ecsimd/curve_nist_p256.h>
 #include <ecsimd/serialization.h>
 #include <ecsimd/literals.h>
 
@@ -78,6 +90,29 @@ void bench_add(benchmark::State& S) {
   }
 }
 
+// 8 dependent additions (or subtractions), with carries rippled or
+// resolved with the lookahead
+template <class Bignum, bool Sub, bool Lookahead>
+void bench_add_carry(benchmark::State& S) {
+  wide_bignum<Bignum> bn0([](auto i, auto _) { return random_bn<Bignum>(); });
+  wide_bignum<Bignum> bn1([](auto i, auto _) { return random_bn<Bignum>(); });
+
+  auto func = [](auto a, auto const& b) __attribute__((noinline)) {
+    for (size_t i = 0; i < 8; ++i) {
+      if constexpr (Sub) {
+        a = std::get<0>(Lookahead ? sub_lookahead(a,b) : sub_ripple(a,b));
+      }
+      else {
+        a = std::get<0>(Lookahead ? add_lookahead(a,b) : add_ripple(a,b));
+      }
+    }
+    return a;
+  };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(bn0, bn1));
+  }
+}
+
 void bench_mgry_sqr(benchmark::State& S) {
   using BN = bignum_256;
   wide_bignum<BN> bn([](auto i, auto _) { return random_bn<BN, true>(); });
@@ -89,6 +124,54 @@ void bench_mgry_sqr(benchmark::State& S) {
   }
 }
 
+// Unfused Montgomery squaring/multiplication: full product, then reduction
+void bench_mgry_sqr_reduce(benchmark::State& S) {
+  using BN = bignum_256;
+  wide_bignum<BN> bn([](auto i, auto _) { return random_bn<BN, true>(); });
+
+  auto func = [](auto const& a) __attribute__((noinline)) { return details::mgry_reduce<P>(square(a)); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(bn));
+  }
+}
+
+void bench_mgry_mul_reduce(benchmark::State& S) {
+  using BN = bignum_256;
+  wide_bignum<BN> a([](auto i, auto _) { return random_bn<BN, true>(); });
+  wide_bignum<BN> b([](auto i, auto _) { return random_bn<BN, true>(); });
+
+  auto func = [](auto const& a, auto const& b) __attribute__((noinline)) { return details::mgry_reduce<P>(mul(a, b)); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a, b));
+  }
+}
+
+void bench_mgry_mul(benchmark::State& S) {
+  using BN = bignum_256;
+  using WMBN = wide_mgry_bignum<wide_bignum<BN>, P>;
+  const auto a = WMBN::from_classical(wide_bignum<BN>([](auto i, auto _) { return random_bn<BN, true>(); }));
+  const auto b = WMBN::from_classical(wide_bignum<BN>([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& a, auto const& b) __attribute__((noinline)) { return mgry_mul(a, b); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a, b));
+  }
+}
+
+template <class Cardinal>
+void bench_mgry_mul_r52(benchmark::State& S) {
+  using BN = bignum_256;
+  using WBN = eve::wide<BN, Cardinal>;
+  using WMBN = wide_mgry_r52<WBN, P>;
+  const auto a = WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+  const auto b = WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& a, auto const& b) __attribute__((noinline)) { return mgry_mul(a, b); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a, b));
+  }
+}
+
 void bench_mgry_reduce(benchmark::State& S) {
   using BN = bignum_512;
   wide_bignum<BN> bn([](auto i, auto _) { return random_bn<BN, true>(); });
@@ -99,12 +182,281 @@ void bench_mgry_reduce(benchmark::State& S) {
   }
 }
 
+// Modular multiplication/squaring with the representation WMBN (Montgomery or
+// special form)
+template <class WMBN>
+void bench_mulmod(benchmark::State& S) {
+  using BN = bn_t<typename WMBN::P_type>;
+  using WBN = eve::wide<BN, eve::cardinal_t<typename WMBN::wide_bignum_type>>;
+  const auto a = WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+  const auto b = WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& a, auto const& b) __attribute__((noinline)) { return mgry_mul(a, b); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a, b));
+  }
+}
+
+template <class WMBN>
+void bench_addmod(benchmark::State& S) {
+  using BN = bn_t<typename WMBN::P_type>;
+  using WBN = eve::wide<BN, eve::cardinal_t<typename WMBN::wide_bignum_type>>;
+  const auto a = WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+  const auto b = WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& a, auto const& b) __attribute__((noinline)) { return mgry_add(a, b); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a, b));
+  }
+}
+
+template <class WMBN>
+void bench_sqrmod(benchmark::State& S) {
+  using BN = bn_t<typename WMBN::P_type>;
+  using WBN = eve::wide<BN, eve::cardinal_t<typename WMBN::wide_bignum_type>>;
+  const auto a = WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& a) __attribute__((noinline)) { return mgry_sqr(a); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a));
+  }
+}
+
+// K*a, with mgry_mul_small or a chain of modular shifts and additions
+template <class WMBN, uint64_t K, bool Kernel>
+void bench_mul_small(benchmark::State& S) {
+  using BN = bn_t<typename WMBN::P_type>;
+  using WBN = eve::wide<BN, eve::cardinal_t<typename WMBN::wide_bignum_type>>;
+  const auto a = WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& a) __attribute__((noinline)) {
+    if constexpr (Kernel) {
+      return mgry_mul_small<K>(a);
+    }
+    else {
+      return details::mgry_mul_small_chain<K>(a);
+    }
+  };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a));
+  }
+}
+
+// a*b - c*d - e and a**2 - b - c, with mgry_sum_of_products or chained
+// operations
+template <class WMBN, bool Kernel>
+void bench_sum_of_products(benchmark::State& S) {
+  using BN = bn_t<typename WMBN::P_type>;
+  using WBN = eve::wide<BN, eve::cardinal_t<typename WMBN::wide_bignum_type>>;
+  auto random_wmbn = []() { return WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); })); };
+  const auto a = random_wmbn();
+  const auto b = random_wmbn();
+  const auto c = random_wmbn();
+
+  auto func = [](auto const& a, auto const& b, auto const& c) __attribute__((noinline)) {
+    if constexpr (Kernel) {
+      const auto r = mgry_sum_of_products(mul_term(a, b), -mul_term(c, a), -add_term(b));
+      return mgry_sum_of_products(sqr_term(r), -add_term(a), -add_term(c));
+    }
+    else {
+      const auto r = details::sop_chain(mul_term(a, b), -mul_term(c, a), -add_term(b));
+      return details::sop_chain(sqr_term(r), -add_term(a), -add_term(c));
+    }
+  };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a, b, c));
+  }
+}
+
+// 32 consecutive squarings, chained or with mgry_sqr_n
+template <class WMBN, bool Fused>
+void bench_sqrmod_n(benchmark::State& S) {
+  using BN = bn_t<typename WMBN::P_type>;
+  using WBN = eve::wide<BN, eve::cardinal_t<typename WMBN::wide_bignum_type>>;
+  const auto a = WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& a) __attribute__((noinline)) {
+    if constexpr (Fused) {
+      return mgry_sqr_n<32>(a);
+    }
+    else {
+      auto ret = a;
+      for (size_t i = 0; i < 32; ++i) {
+        ret = mgry_sqr(ret);
+      }
+      return ret;
+    }
+  };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a));
+  }
+}
+
+template <class GFP, inversion_strategy S>
+void bench_inverse(benchmark::State& S_) {
+  using BN = typename GFP::BN;
+  using WBN = typename GFP::WBN;
+  const auto a = GFP::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& a) __attribute__((noinline)) { return a.template inverse<S>(); };
+  for (auto _: S_) {
+    benchmark::DoNotOptimize(func(a));
+  }
+}
+
+template <class GFP>
+void bench_sqrt(benchmark::State& S) {
+  using BN = typename GFP::BN;
+  using WBN = typename GFP::WBN;
+  const auto a = GFP::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& a) __attribute__((noinline)) { return a.sqrt(); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a));
+  }
+}
+
+template <class GFP>
+void bench_legendre(benchmark::State& S) {
+  using BN = typename GFP::BN;
+  using WBN = typename GFP::WBN;
+  const auto a = GFP::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& a) __attribute__((noinline)) { return a.legendre(); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a));
+  }
+}
+
+// Reduction of a random number twice as large as p (e.g. a hash), and
+// conversion back to the classical form
+template <class GFP>
+void bench_reduce_wide(benchmark::State& S) {
+  using BN = typename GFP::BN;
+  using WD = wbn_zext_t<typename GFP::WBN>;
+  using BN2 = typename WD::value_type;
+  const WD a([](auto i, auto _) { return random_bn<BN2>(); });
+
+  auto func = [](auto const& a) __attribute__((noinline)) { return GFP::from_classical_wide(a).to_classical(); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a));
+  }
+}
+
+// Same as bench_mulmod/bench_sqrmod/bench_pow, with a runtime modulus
+template <class WBN, class P>
+void bench_ctx_mulmod(benchmark::State& S) {
+  using BN = typename WBN::value_type;
+  const mgry_context<WBN> ctx{WBN{P::value}};
+  const auto a = ctx.from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+  const auto b = ctx.from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& ctx, auto const& a, auto const& b) __attribute__((noinline)) { return ctx.mul(a, b); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(ctx, a, b));
+  }
+}
+
+template <class WBN, class P>
+void bench_ctx_sqrmod(benchmark::State& S) {
+  using BN = typename WBN::value_type;
+  const mgry_context<WBN> ctx{WBN{P::value}};
+  const auto a = ctx.from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+
+  auto func = [](auto const& ctx, auto const& a) __attribute__((noinline)) { return ctx.sqr(a); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(ctx, a));
+  }
+}
+
+template <class WBN, class P>
+void bench_ctx_pow(benchmark::State& S) {
+  using BN = typename WBN::value_type;
+  const mgry_context<WBN> ctx{WBN{P::value}};
+  const auto a = ctx.from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+  const auto we = WBN([](auto i, auto _) { return random_bn<BN>(); });
+
+  auto func = [](auto const& ctx, auto const& a, auto const& we) __attribute__((noinline)) { return ctx.pow(a, we); };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(ctx, a, we));
+  }
+}
+
+// Full products of Bits-bit numbers over wide_digits, schoolbook or Karatsuba
+// (see karatsuba_threshold_digits)
+template <size_t Bits, bool Karatsuba>
+void bench_mul_digits(benchmark::State& S) {
+  using BN = bignum<uint64_t, Bits/64>;
+  using WBN = wide_bignum<BN>;
+  const auto a = to_digits(WBN([](auto i, auto _) { return random_bn<BN>(); }));
+  const auto b = to_digits(WBN([](auto i, auto _) { return random_bn<BN>(); }));
+
+  auto func = [](auto const& a, auto const& b) __attribute__((noinline)) {
+    if constexpr (Karatsuba) {
+      return digits_mul_karatsuba(a, b);
+    }
+    else {
+      return digits_mul(a, b);
+    }
+  };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a, b));
+  }
+}
+
+// a**e with a random 256-bit exponent, shared by all the lanes or not
+enum class pow_kind { binary, ladder, window, window_lanes };
+
+template <class WMBN, pow_kind K>
+void bench_pow(benchmark::State& S) {
+  using BN = bn_t<typename WMBN::P_type>;
+  using WBN = eve::wide<BN, eve::cardinal_t<typename WMBN::wide_bignum_type>>;
+  const auto a = WMBN::from_classical(WBN([](auto i, auto _) { return random_bn<BN, true>(); }));
+  const auto e = random_bn<BN>();
+  const auto we = WBN([](auto i, auto _) { return random_bn<BN>(); });
+
+  auto func = [](auto const& a, auto const& e, auto const& we) __attribute__((noinline)) {
+    if constexpr (K == pow_kind::binary) {
+      return mgry_pow(a, e);
+    }
+    else if constexpr (K == pow_kind::ladder) {
+      return mgry_pow_ladder(a, e);
+    }
+    else if constexpr (K == pow_kind::window) {
+      return mgry_pow_window(a, e);
+    }
+    else {
+      return mgry_pow_window(a, we);
+    }
+  };
+  for (auto _: S) {
+    benchmark::DoNotOptimize(func(a, e, we));
+  }
+}
+
 } // anonymous
 
 int main(int argc, char** argv)
 {
   benchmark::RegisterBenchmark("add_256", &bench_add<bignum_128>);
 
+  benchmark::RegisterBenchmark("add8_256_ripple", &bench_add_carry<bignum_256, false, false>);
+  benchmark::RegisterBenchmark("add8_256_lookahead", &bench_add_carry<bignum_256, false, true>);
+  benchmark::RegisterBenchmark("add8_384_ripple", &bench_add_carry<bignum<uint64_t, 6>, false, false>);
+  benchmark::RegisterBenchmark("add8_384_lookahead", &bench_add_carry<bignum<uint64_t, 6>, false, true>);
+  benchmark::RegisterBenchmark("add8_512_ripple", &bench_add_carry<bignum<uint64_t, 8>, false, false>);
+  benchmark::RegisterBenchmark("add8_512_lookahead", &bench_add_carry<bignum<uint64_t, 8>, false, true>);
+  benchmark::RegisterBenchmark("add8_1024_ripple", &bench_add_carry<bignum<uint64_t, 16>, false, false>);
+  benchmark::RegisterBenchmark("add8_1024_lookahead", &bench_add_carry<bignum<uint64_t, 16>, false, true>);
+  benchmark::RegisterBenchmark("sub8_256_ripple", &bench_add_carry<bignum_256, true, false>);
+  benchmark::RegisterBenchmark("sub8_256_lookahead", &bench_add_carry<bignum_256, true, true>);
+  benchmark::RegisterBenchmark("sub8_384_ripple", &bench_add_carry<bignum<uint64_t, 6>, true, false>);
+  benchmark::RegisterBenchmark("sub8_384_lookahead", &bench_add_carry<bignum<uint64_t, 6>, true, true>);
+  benchmark::RegisterBenchmark("sub8_512_ripple", &bench_add_carry<bignum<uint64_t, 8>, true, false>);
+  benchmark::RegisterBenchmark("sub8_512_lookahead", &bench_add_carry<bignum<uint64_t, 8>, true, true>);
+  benchmark::RegisterBenchmark("sub8_1024_ripple", &bench_add_carry<bignum<uint64_t, 16>, true, false>);
+  benchmark::RegisterBenchmark("sub8_1024_lookahead", &bench_add_carry<bignum<uint64_t, 16>, true, true>);
+
   benchmark::RegisterBenchmark("mul_128", &bench_mul<bignum_128>);
   benchmark::RegisterBenchmark("mul_256", &bench_mul<bignum_256>);
   benchmark::RegisterBenchmark("mul_limb_256", &bench_mul_limb<bignum_256>);
@@ -112,9 +464,93 @@ int main(int argc, char** argv)
   benchmark::RegisterBenchmark("sqr_128", &bench_sqr<bignum_128>);
   benchmark::RegisterBenchmark("sqr_256", &bench_sqr<bignum_256>);
   benchmark::RegisterBenchmark("mgry_sqr_256", bench_mgry_sqr);
+  benchmark::RegisterBenchmark("mgry_sqr_reduce_256", bench_mgry_sqr_reduce);
 
   benchmark::RegisterBenchmark("mgry_reduce_512", bench_mgry_reduce);
 
+  benchmark::RegisterBenchmark("mul_512", &bench_mul<bignum<uint64_t, 8>>);
+  benchmark::RegisterBenchmark("mul_1024", &bench_mul<bignum<uint64_t, 16>>);
+  benchmark::RegisterBenchmark("mul_256_schoolbook", &bench_mul_digits<256, false>);
+  benchmark::RegisterBenchmark("mul_256_karatsuba", &bench_mul_digits<256, true>);
+  benchmark::RegisterBenchmark("mul_512_schoolbook", &bench_mul_digits<512, false>);
+  benchmark::RegisterBenchmark("mul_512_karatsuba", &bench_mul_digits<512, true>);
+  benchmark::RegisterBenchmark("mul_1024_schoolbook", &bench_mul_digits<1024, false>);
+  benchmark::RegisterBenchmark("mul_1024_karatsuba", &bench_mul_digits<1024, true>);
+  benchmark::RegisterBenchmark("mul_2048_schoolbook", &bench_mul_digits<2048, false>);
+  benchmark::RegisterBenchmark("mul_2048_karatsuba", &bench_mul_digits<2048, true>);
+  benchmark::RegisterBenchmark("mul_4096_schoolbook", &bench_mul_digits<4096, false>);
+  benchmark::RegisterBenchmark("mul_4096_karatsuba", &bench_mul_digits<4096, true>);
+
+  benchmark::RegisterBenchmark("mgry_mul_256_x4", bench_mgry_mul);
+  benchmark::RegisterBenchmark("mgry_mul_reduce_256_x4", bench_mgry_mul_reduce);
+  benchmark::RegisterBenchmark("mgry_mul_256_r52_x4", bench_mgry_mul_r52<eve::fixed<4>>);
+  benchmark::RegisterBenchmark("mgry_mul_256_r52_x8", bench_mgry_mul_r52<eve::fixed<8>>);
+
+  {
+    using WBN = wide_bignum<bignum_256>;
+    using P256 = curve_nist_p256::P;
+    benchmark::RegisterBenchmark("mulmod_p256_mgry_x4", bench_mulmod<wide_mgry_bignum<WBN, P256>>);
+    benchmark::RegisterBenchmark("mulmod_p256_solinas_x4", bench_mulmod<wide_special_bignum<WBN, P256>>);
+    benchmark::RegisterBenchmark("mulmod_k1_mgry_x4", bench_mulmod<wide_mgry_bignum<WBN, P>>);
+    benchmark::RegisterBenchmark("mulmod_k1_mgry_u32x64_x4", bench_mulmod<wide_mgry_u32x64<WBN, P>>);
+    benchmark::RegisterBenchmark("mulmod_k1_r29_x4", bench_mulmod<wide_mgry_r29<WBN, P>>);
+    benchmark::RegisterBenchmark("mulmod_k1_pmersenne_x4", bench_mulmod<wide_special_bignum<WBN, P>>);
+    benchmark::RegisterBenchmark("sqrmod_p256_mgry_x4", bench_sqrmod<wide_mgry_bignum<WBN, P256>>);
+    benchmark::RegisterBenchmark("sqrmod_p256_solinas_x4", bench_sqrmod<wide_special_bignum<WBN, P256>>);
+    benchmark::RegisterBenchmark("sqrmod_k1_mgry_x4", bench_sqrmod<wide_mgry_bignum<WBN, P>>);
+    benchmark::RegisterBenchmark("sqrmod_k1_mgry_u32x64_x4", bench_sqrmod<wide_mgry_u32x64<WBN, P>>);
+    benchmark::RegisterBenchmark("addmod_k1_mgry_x4", bench_addmod<wide_mgry_bignum<WBN, P>>);
+    benchmark::RegisterBenchmark("addmod_k1_mgry_u32x64_x4", bench_addmod<wide_mgry_u32x64<WBN, P>>);
+    benchmark::RegisterBenchmark("addmod_k1_r29_x4", bench_addmod<wide_mgry_r29<WBN, P>>);
+    benchmark::RegisterBenchmark("sqrmod_k1_pmersenne_x4", bench_sqrmod<wide_special_bignum<WBN, P>>);
+    benchmark::RegisterBenchmark("mul3_p256_chain_x4", bench_mul_small<wide_special_bignum<WBN, P256>, 3, false>);
+    benchmark::RegisterBenchmark("mul3_p256_x4", bench_mul_small<wide_special_bignum<WBN, P256>, 3, true>);
+    benchmark::RegisterBenchmark("mul4_p256_chain_x4", bench_mul_small<wide_special_bignum<WBN, P256>, 4, false>);
+    benchmark::RegisterBenchmark("mul4_p256_x4", bench_mul_small<wide_special_bignum<WBN, P256>, 4, true>);
+    benchmark::RegisterBenchmark("mul8_p256_chain_x4", bench_mul_small<wide_special_bignum<WBN, P256>, 8, false>);
+    benchmark::RegisterBenchmark("mul8_p256_x4", bench_mul_small<wide_special_bignum<WBN, P256>, 8, true>);
+    benchmark::RegisterBenchmark("mul8_k1_u32x64_chain_x4", bench_mul_small<wide_mgry_u32x64<WBN, P>, 8, false>);
+    benchmark::RegisterBenchmark("mul8_k1_u32x64_x4", bench_mul_small<wide_mgry_u32x64<WBN, P>, 8, true>);
+    benchmark::RegisterBenchmark("sop_p256_chain_x4", bench_sum_of_products<wide_special_bignum<WBN, P256>, false>);
+    benchmark::RegisterBenchmark("sop_p256_x4", bench_sum_of_products<wide_special_bignum<WBN, P256>, true>);
+    benchmark::RegisterBenchmark("sop_p256_mgry_chain_x4", bench_sum_of_products<wide_mgry_bignum<WBN, P256>, false>);
+    benchmark::RegisterBenchmark("sop_p256_mgry_x4", bench_sum_of_products<wide_mgry_bignum<WBN, P256>, true>);
+    benchmark::RegisterBenchmark("sop_k1_chain_x4", bench_sum_of_products<wide_special_bignum<WBN, P>, false>);
+    benchmark::RegisterBenchmark("sop_k1_x4", bench_sum_of_products<wide_special_bignum<WBN, P>, true>);
+    benchmark::RegisterBenchmark("sqrmod_32_p256_mgry_x4", bench_sqrmod_n<wide_mgry_bignum<WBN, P256>, false>);
+    benchmark::RegisterBenchmark("sqrmod_n_32_p256_mgry_x4", bench_sqrmod_n<wide_mgry_bignum<WBN, P256>, true>);
+
+    benchmark::RegisterBenchmark("pow_p256_mgry_x4", bench_pow<wide_mgry_bignum<WBN, P256>, pow_kind::binary>)->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark("pow_ladder_p256_mgry_x4", bench_pow<wide_mgry_bignum<WBN, P256>, pow_kind::ladder>)->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark("pow_window_p256_mgry_x4", bench_pow<wide_mgry_bignum<WBN, P256>, pow_kind::window>)->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark("pow_window_lanes_p256_mgry_x4", bench_pow<wide_mgry_bignum<WBN, P256>, pow_kind::window_lanes>)->Unit(benchmark::kMicrosecond);
+    benchmark::RegisterBenchmark("mulmod_p256_ctx_x4", bench_ctx_mulmod<WBN, P256>);
+    benchmark::RegisterBenchmark("sqrmod_p256_ctx_x4", bench_ctx_sqrmod<WBN, P256>);
+    benchmark::RegisterBenchmark("pow_window_lanes_p256_ctx_x4", bench_ctx_pow<WBN, P256>)->Unit(benchmark::kMicrosecond);
+
+    using GFP256 = GFp<WBN, P256>;
+    benchmark::RegisterBenchmark("inverse_p256_fermat_x4", bench_inverse<GFP256, inversion_strategy::fermat>);
+    benchmark::RegisterBenchmark("inverse_p256_safegcd_x4", bench_inverse<GFP256, inversion_strategy::safegcd>);
+    benchmark::RegisterBenchmark("sqrt_p256_x4", bench_sqrt<GFP256>);
+    benchmark::RegisterBenchmark("legendre_p256_x4", bench_legendre<GFP256>);
+    using GFP256_mgry = GFp<WBN, P256, wide_mgry_bignum<WBN, P256>>;
+    benchmark::RegisterBenchmark("inverse_p256_mgry_fermat_x4", bench_inverse<GFP256_mgry, inversion_strategy::fermat>);
+    benchmark::RegisterBenchmark("inverse_p256_mgry_safegcd_x4", bench_inverse<GFP256_mgry, inversion_strategy::safegcd>);
+
+    using GFN256 = GFn<curve_nist_p256, eve::fixed<4>>;
+    benchmark::RegisterBenchmark("mulmod_n256_mgry_x4", bench_mulmod<typename GFN256::WMBN>);
+    benchmark::RegisterBenchmark("inverse_n256_fermat_x4", bench_inverse<GFN256, inversion_strategy::fermat>);
+    benchmark::RegisterBenchmark("inverse_n256_safegcd_x4", bench_inverse<GFN256, inversion_strategy::safegcd>);
+
+    using N256 = curve_nist_p256::N;
+    benchmark::RegisterBenchmark("mulmod_n256_barrett_x4", bench_mulmod<wide_barrett_bignum<WBN, N256>>);
+    benchmark::RegisterBenchmark("sqrmod_n256_barrett_x4", bench_sqrmod<wide_barrett_bignum<WBN, N256>>);
+    benchmark::RegisterBenchmark("sqrmod_n256_mgry_x4", bench_sqrmod<typename GFN256::WMBN>);
+    benchmark::RegisterBenchmark("mulmod_p256_barrett_x4", bench_mulmod<wide_barrett_bignum<WBN, P256>>);
+    benchmark::RegisterBenchmark("reduce_wide_n256_mgry_x4", bench_reduce_wide<GFp<WBN, N256>>);
+    benchmark::RegisterBenchmark("reduce_wide_n256_barrett_x4", bench_reduce_wide<GFp<WBN, N256, wide_barrett_bignum<WBN, N256>>>);
+  }
+
   benchmark::Initialize(&argc, argv);
   benchmark::RunSpecifiedBenchmarks();
 
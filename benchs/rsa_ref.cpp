@@ -0,0 +1,136 @@
+#include <ecsimd/rsa.h>
+#include <ecsimd/serialization.h>
+
+// OpenSSL
+#include <openssl/bn.h>
+#include <openssl/core_names.h>
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <vector>
+
+using namespace ecsimd;
+
+namespace {
+
+// Raw RSA (no padding) with the same key in every lane. The number of
+// messages processed per second is reported as items_per_second.
+
+EVP_PKEY* gen_key(unsigned bits) {
+  EVP_PKEY* key = EVP_RSA_gen(bits);
+  if (!key) {
+    printf("error: EVP_RSA_gen\n");
+  }
+  return key;
+}
+
+template <class BN>
+BN key_param(EVP_PKEY* key, const char* name) {
+  BIGNUM* v = nullptr;
+  if (!EVP_PKEY_get_bn_param(key, name, &v)) {
+    printf("error: EVP_PKEY_get_bn_param(%s)\n", name);
+    return {};
+  }
+  std::array<uint8_t, sizeof(BN)> bytes;
+  BN_bn2binpad(v, bytes.data(), bytes.size());
+  BN_free(v);
+  return bn_from_bytes_BE<BN>(bytes);
+}
+
+template <size_t Bits, class Cardinal, bool Private>
+void bench_ecsimd(benchmark::State& S) {
+  using RSA = wide_rsa<Bits, Cardinal>;
+  using WBN = typename RSA::WBN;
+  using WHBN = typename RSA::WHBN;
+  using BN = typename RSA::bignum_type;
+  using HBN = typename RSA::half_bignum_type;
+
+  EVP_PKEY* key = gen_key(Bits);
+  const WBN n{key_param<BN>(key, OSSL_PKEY_PARAM_RSA_N)};
+  const typename RSA::public_key pub{n};
+  const typename RSA::private_key priv{
+    WHBN{key_param<HBN>(key, OSSL_PKEY_PARAM_RSA_FACTOR1)},
+    WHBN{key_param<HBN>(key, OSSL_PKEY_PARAM_RSA_FACTOR2)},
+    WHBN{key_param<HBN>(key, OSSL_PKEY_PARAM_RSA_EXPONENT1)},
+    WHBN{key_param<HBN>(key, OSSL_PKEY_PARAM_RSA_EXPONENT2)},
+    WHBN{key_param<HBN>(key, OSSL_PKEY_PARAM_RSA_COEFFICIENT1)}};
+  EVP_PKEY_free(key);
+
+  // x < n
+  const auto x = WBN{[&](auto i, auto _) {
+    auto v = n.get(0).cbn();
+    v[0] ^= i+1;
+    v[v.size()-1] >>= 1;
+    return BN::from(v);
+  }};
+
+  for (auto _: S) {
+    if constexpr (Private) {
+      benchmark::DoNotOptimize(priv.apply(x));
+    }
+    else {
+      benchmark::DoNotOptimize(pub.apply(x));
+    }
+  }
+  S.SetItemsProcessed(S.iterations() * WBN::size());
+}
+
+template <unsigned Bits, bool Private>
+void bench_openssl(benchmark::State& S) {
+  EVP_PKEY* key = gen_key(Bits);
+  EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new(key, nullptr);
+  if (!ctx) {
+    printf("error: EVP_PKEY_CTX_new\n");
+    return;
+  }
+  if ((Private ? EVP_PKEY_decrypt_init(ctx) : EVP_PKEY_encrypt_init(ctx)) <= 0 ||
+      EVP_PKEY_CTX_set_rsa_padding(ctx, RSA_NO_PADDING) <= 0) {
+    printf("error: unable to initialize the openssl RSA context\n");
+    return;
+  }
+
+  std::vector<uint8_t> in(Bits/8, 0x5a);
+  in[0] = 0;
+  std::vector<uint8_t> out(Bits/8);
+
+  for (auto _: S) {
+    size_t outlen = out.size();
+    if constexpr (Private) {
+      EVP_PKEY_decrypt(ctx, out.data(), &outlen, in.data(), in.size());
+    }
+    else {
+      EVP_PKEY_encrypt(ctx, out.data(), &outlen, in.data(), in.size());
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  S.SetItemsProcessed(S.iterations());
+
+  EVP_PKEY_CTX_free(ctx);
+  EVP_PKEY_free(key);
+}
+
+} // anonymous
+
+int main(int argc, char** argv)
+{
+  benchmark::RegisterBenchmark("rsa2048_public_ecsimd_x4", bench_ecsimd<2048, eve::fixed<4>, false>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("rsa2048_public_openssl", bench_openssl<2048, false>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("rsa2048_private_ecsimd_x4", bench_ecsimd<2048, eve::fixed<4>, true>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("rsa2048_private_openssl", bench_openssl<2048, true>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("rsa4096_public_ecsimd_x4", bench_ecsimd<4096, eve::fixed<4>, false>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("rsa4096_public_openssl", bench_openssl<4096, false>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("rsa4096_private_ecsimd_x4", bench_ecsimd<4096, eve::fixed<4>, true>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("rsa4096_private_openssl", bench_openssl<4096, true>)->Unit(benchmark::kMicrosecond);
+#ifdef __AVX512F__
+  benchmark::RegisterBenchmark("rsa2048_public_ecsimd_x8", bench_ecsimd<2048, eve::fixed<8>, false>)->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("rsa2048_private_ecsimd_x8", bench_ecsimd<2048, eve::fixed<8>, true>)->Unit(benchmark::kMicrosecond);
+#endif
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+
+  return 0;
+}
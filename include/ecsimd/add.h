@@ -2,14 +2,20 @@
 #define FPSIMD_BIGINT_ADD_H
 
 #include <eve/wide.hpp>
+#include <eve/detail/top_bits.hpp>
 #include <ecsimd/bignum.h>
 
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <tuple>
+#include <type_traits>
 
 namespace ecsimd {
 
+// Carries ripple through the limbs, one after the other
 template <concepts::wide_bignum WBN>
-static auto add(WBN const& a, WBN const& b)
+static auto add_ripple(WBN const& a, WBN const& b)
 {
   constexpr auto nlimbs = bn_nlimbs<WBN>;
 
@@ -34,6 +40,144 @@ static auto add(WBN const& a, WBN const& b)
   return std::make_tuple(ret, carry_mask);
 }
 
+namespace details {
+
+// Bits C*i of a N*C-bit number
+template <class T, size_t N, size_t C>
+constexpr T lane_bits() {
+  T ret = 0;
+  for (size_t i = 0; i < N; ++i) {
+    ret |= T{1} << (C*i);
+  }
+  return ret;
+}
+
+// The storage of top_bits is an integer, an AVX-512 mask, or the top_bits of
+// both halves of the logical (e.g. 8 64-bit lanes on AVX2)
+template <class T, class TB>
+static T top_bits_to_int(TB const& v)
+{
+  if constexpr (TB::is_aggregated) {
+    constexpr size_t half = TB::static_size/2;
+    return top_bits_to_int<T>(v.storage[0]) | (top_bits_to_int<T>(v.storage[1]) << half);
+  }
+  else if constexpr (requires { v.storage.value; }) {
+    return T(v.storage.value);
+  }
+  else {
+    return T(v.storage);
+  }
+}
+
+template <class TB, class T>
+static TB top_bits_from_int(T v)
+{
+  using storage_type = typename TB::storage_type;
+  if constexpr (TB::is_aggregated) {
+    using half_tb = typename storage_type::value_type;
+    constexpr size_t half = TB::static_size/2;
+    constexpr T half_mask = (T{1} << half) - 1;
+    return TB{storage_type{top_bits_from_int<half_tb>(v & half_mask),
+                           top_bits_from_int<half_tb>(v >> half)}};
+  }
+  else if constexpr (requires { storage_type::bits; }) {
+    return TB{storage_type{static_cast<typename storage_type::type>(v)}};
+  }
+  else {
+    return TB{static_cast<storage_type>(v)};
+  }
+}
+
+// Carry-lookahead: g[i] and p[i] are the lanes where limb i respectively
+// generates and propagates a carry. They are gathered in a scalar (bit C*i+l
+// being lane l of limb i, with C lanes), and the carries of each lane are
+// resolved with one addition, the bits of the other lanes being set to
+// propagate (see e.g. Hacker's Delight, 2-16). On return, g[i] is the carry
+// out of limb i.
+template <size_t N, class M>
+static void carry_lookahead(std::array<M, N>& g, std::array<M, N> const& p)
+{
+  using tb = eve::detail::top_bits<M>;
+  constexpr size_t C = M::size();
+  static_assert(tb::bits_per_element == 1 && N*C <= 128);
+  using T = std::conditional_t<N*C <= 64, uint64_t, unsigned __int128>;
+
+  T G = 0;
+  T P = 0;
+  eve::detail::for_<0,1,N>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    G |= top_bits_to_int<T>(tb{g[i]}) << (C*i);
+    P |= top_bits_to_int<T>(tb{p[i]}) << (C*i);
+  });
+
+  T carries = 0;
+  eve::detail::for_<0,1,C>([&](auto l_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto l = decltype(l_)::value;
+    constexpr T lane = lane_bits<T, N, C>() << l;
+    const T Pl = P | ~lane;
+    carries |= ((((G & lane) << C) + Pl) ^ Pl) & lane;
+  });
+
+  // The carry into limb i is the one out of limb i-1
+  constexpr T lanes_mask = (T{1} << C) - 1;
+  eve::detail::for_<1,1,N>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    g[i-1] = eve::detail::to_logical(top_bits_from_int<tb>((carries >> (C*i)) & lanes_mask));
+  });
+  if constexpr (N > 1) {
+    g[N-1] = g[N-1] || (p[N-1] && g[N-2]);
+  }
+}
+
+} // details
+
+// Generate and propagate masks are computed for all the limbs at once, and
+// carries applied in one step (see details::carry_lookahead)
+template <concepts::wide_bignum WBN>
+static auto add_lookahead(WBN const& a, WBN const& b)
+{
+  using limb_type = bn_limb_t<WBN>;
+  using WL = eve::wide<limb_type, eve::cardinal_t<WBN>>;
+  constexpr auto nlimbs = bn_nlimbs<WBN>;
+
+  WBN sum;
+  std::array<cmp_res_t<WBN>, nlimbs> g, p;
+  eve::detail::for_<0, 1, nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    const auto aa = eve::get<i>(a);
+    eve::get<i>(sum) = aa + eve::get<i>(b);
+    g[i] = eve::get<i>(sum) < aa;
+    p[i] = eve::get<i>(sum) == WL{std::numeric_limits<limb_type>::max()};
+  });
+  details::carry_lookahead(g, p);
+
+  WBN ret;
+  eve::get<0>(ret) = eve::get<0>(sum);
+  eve::detail::for_<1, 1, nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    eve::get<i>(ret) = eve::get<i>(sum) - g[i-1].mask();
+  });
+  return std::make_tuple(ret, g[nlimbs-1]);
+}
+
+// Rippling carries is latency bound, but needs less operations: the
+// lookahead pays off while the masks of all the limbs fit in a few scalar
+// bits (see the add8_* and sub8_* benchmarks).
+template <concepts::wide_bignum WBN>
+constexpr bool use_carry_lookahead = bn_nlimbs<WBN> > 4 &&
+  bn_nlimbs<WBN>*eve::cardinal_v<WBN> <= 48;
+
+template <concepts::wide_bignum WBN>
+static auto add(WBN const& a, WBN const& b)
+{
+  if constexpr (use_carry_lookahead<WBN>) {
+    return add_lookahead(a, b);
+  }
+  else {
+    return add_ripple(a, b);
+  }
+}
+
 template <concepts::wide_bignum WBN>
 static auto add_no_carry(WBN const& a, WBN const& b)
 {
@@ -0,0 +1,79 @@
+#ifndef ECSIMD_ADDCHAIN_H
+#define ECSIMD_ADDCHAIN_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/curve_nist_p256.h>
+
+namespace ecsimd {
+
+// Fixed addition chains for the exponentiations by the constants p-2
+// (inversion), (p+1)/4 (square root) and (p-1)/2 (Euler's criterion) of a
+// given prime. F is any field
+// type providing sqr(), sqr_n<N>() and operator* (e.g. GFp). Primes without
+// a specialization fall back to the generic mgry_pow.
+template <concepts::bignum_cst P>
+struct addition_chain {
+  static constexpr bool available = false;
+};
+
+template <>
+struct addition_chain<curve_nist_p256::P> {
+  static constexpr bool available = true;
+
+  // x**(2**k-1) for k in {2, 3, 6, 12, 15, 30, 32}: 31 squarings, 7
+  // multiplications
+  template <class F>
+  struct ones {
+    F x1, x2, x3, x6, x12, x15, x30, x32;
+
+    ones(F const& x):
+      x1(x)
+    {
+      x2  = x1.sqr() * x1;
+      x3  = x2.sqr() * x1;
+      x6  = x3.template sqr_n<3>() * x3;
+      x12 = x6.template sqr_n<6>() * x6;
+      x15 = x12.template sqr_n<3>() * x3;
+      x30 = x15.template sqr_n<15>() * x15;
+      x32 = x30.template sqr_n<2>() * x2;
+    }
+  };
+
+  // p-2 = ffffffff 00000001 00000000 00000000 00000000 ffffffff ffffffff fffffffd
+  // 255 squarings, 12 multiplications
+  template <class F>
+  static F inverse(F const& x) {
+    const ones<F> o{x};
+    auto t = o.x32.template sqr_n<32>() * x;
+    t = t.template sqr_n<128>() * o.x32;
+    t = t.template sqr_n<32>() * o.x32;
+    t = t.template sqr_n<30>() * o.x30;
+    return t.template sqr_n<2>() * x;
+  }
+
+  // (p+1)/4 = 2**254 - 2**222 + 2**190 + 2**94
+  // 253 squarings, 9 multiplications
+  template <class F>
+  static F sqrt(F const& x) {
+    const ones<F> o{x};
+    auto t = o.x32.template sqr_n<32>() * x;
+    t = t.template sqr_n<96>() * x;
+    return t.template sqr_n<94>();
+  }
+
+  // (p-1)/2 = 7fffffff 80000000 80000000 00000000 00000000 7fffffff ffffffff ffffffff
+  // 254 squarings, 12 multiplications
+  template <class F>
+  static F euler(F const& x) {
+    const ones<F> o{x};
+    auto t = o.x32.template sqr_n<32>() * x;
+    t = t.template sqr_n<128>() * o.x32;
+    t = t.template sqr_n<32>() * o.x32;
+    t = t.template sqr_n<30>() * o.x30;
+    return t.template sqr_n<1>() * x;
+  }
+};
+
+} // ecsimd
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef ECSIMD_BARRETT_H
+#define ECSIMD_BARRETT_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/classical_form.h>
+#include <ecsimd/mgry.h>
+#include <ecsimd/mgry_csts.h>
+#include <ecsimd/mgry_mul.h>
+#include <ecsimd/modular.h>
+#include <ecsimd/mul.h>
+#include <ecsimd/shift.h>
+#include <ecsimd/sub.h>
+
+#include <ctbignum/division.hpp>
+#include <ctbignum/slicing.hpp>
+
+#include <eve/wide.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace ecsimd {
+
+// Barrett reduction (HAC 14.42) over 32-bit digits stored in 64-bit lanes
+// (see mul_u32_zext), for any modulus whose most significant digit is not
+// zero. Unlike the Montgomery reduction, it works on classical numbers, so
+// that one-off reductions (hashes, nonces, scalars) need no conversion.
+template <concepts::bignum_cst P>
+struct barrett_constants {
+  using BN = bn_t<P>;
+  static_assert(std::is_same_v<bn_limb_t<BN>, uint64_t>);
+  static constexpr size_t nlimbs = bn_nlimbs<BN>;
+  static constexpr size_t ndigits = 2*nlimbs;
+
+  static constexpr auto p = P::value.cbn();
+  static_assert((p[nlimbs-1] >> 32) != 0, "the most significant digit of P must not be zero");
+
+  // floor(2**(64*ndigits)/p), with ndigits+1 digits
+  static constexpr auto mu = cbn::div(cbn::detail::unary_encoding<2*nlimbs, 2*nlimbs+1>(), p).quotient;
+
+  static constexpr auto mu_digits = []() {
+    std::array<uint64_t, ndigits+1> ret{};
+    for (size_t i = 0; i < ndigits; ++i) {
+      ret[i] = (mu[i/2] >> (32*(i%2))) & 0xFFFFFFFF;
+    }
+    ret[ndigits] = mu[nlimbs] & 0xFFFFFFFF;
+    return ret;
+  }();
+  static_assert((mu[nlimbs] >> 32) == 0);
+};
+
+namespace details {
+
+// t mod P, for t made of 2k 32-bit digits (see mul_u32_zext), with k the
+// number of digits of P. The estimate q of floor(t/p) only uses the partial
+// products of weight b**(k-1) and above, and is at most three lower than
+// floor(t/p): r = t - q*p is thus lower than 4p, and is fully reduced by three
+// conditional subtractions of p.
+template <concepts::bignum_cst P, concepts::wide_bignum WD>
+static auto barrett_reduce_u32_zext(WD const& t)
+{
+  using csts = barrett_constants<P>;
+  using cardinal = eve::cardinal_t<WD>;
+  using WL = eve::wide<uint64_t, cardinal>;
+  using WBN = eve::wide<bn_t<P>, cardinal>;
+  constexpr size_t k = csts::ndigits;
+  static_assert(bn_nlimbs<WD> == 2*k);
+  const WL low_mask{0xFFFFFFFF};
+
+  // q = floor(floor(t/b**(k-1))*mu/b**(k+1)), b = 2**32. Partial products
+  // of weight lower than b**(k-1) are skipped: they sum to less than
+  // b**(k+1), so that q is underestimated by at most one more.
+  eve::wide<bignum<uint64_t, 2*k+2>, cardinal> q2 = eve::zero(eve::as(q2));
+  eve::detail::for_<0,1,k+1>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    constexpr size_t jstart = i < k-1 ? k-1-i : 0;
+    const auto q1 = eve::get<k-1+i>(t);
+    WL highprev = eve::zero(eve::as<WL>());
+    eve::detail::for_<jstart,1,k+1>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto j = decltype(j_)::value;
+      auto v = mullow(q1, WL{csts::mu_digits[j]});
+      v += eve::get<i+j>(q2);
+      v += highprev;
+      eve::get<i+j>(q2) = v & low_mask;
+      highprev = v >> 32;
+    });
+    eve::get<i+k+1>(q2) = highprev;
+  });
+
+  // r = t - q*p mod b**(k+1), with r < 4p
+  eve::wide<bignum<uint64_t, k+1>, cardinal> qp = eve::zero(eve::as(qp));
+  eve::detail::for_<0,1,k+1>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    const auto q = eve::get<k+1+i>(q2);
+    WL highprev = eve::zero(eve::as<WL>());
+    eve::detail::for_<0,1,std::min<size_t>(k, k+1-i)>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto j = decltype(j_)::value;
+      auto v = mullow(q, WL{mgry_cst_p<P, cardinal>::digits[j]});
+      v += eve::get<i+j>(qp);
+      v += highprev;
+      eve::get<i+j>(qp) = v & low_mask;
+      highprev = v >> 32;
+    });
+    if constexpr (i+k < k+1) {
+      eve::get<i+k>(qp) = highprev;
+    }
+  });
+
+  eve::wide<bignum<uint64_t, k+2>, cardinal> r;
+  eve::detail::for_<0,1,k+1>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    eve::get<i>(r) = eve::get<i>(t) - eve::get<i>(qp);
+  });
+  eve::get<k+1>(r) = eve::zero(eve::as<WL>());
+  // The borrow out of the digit k is the multiple of b**(k+1) to drop
+  propagate_u32_zext<true>(r);
+  eve::get<k+1>(r) = eve::zero(eve::as<WL>());
+
+  const auto wide_P = pad<1>(mgry_constants<WBN, P>::wide_P);
+  auto ret = trunc_u64x32(r);
+  ret = sub_if_above(ret, wide_P);
+  ret = sub_if_above(ret, wide_P);
+  return sub_if_above<bn_nlimbs<WBN>>(ret, wide_P);
+}
+
+} // details
+
+// t mod P, for any t with twice as many limbs as P
+template <concepts::bignum_cst P, concepts::wide_bignum WD>
+auto barrett_reduce(WD const& t)
+{
+  static_assert(bn_nlimbs<WD> == 2*bn_nlimbs<bn_t<P>>);
+  return details::barrett_reduce_u32_zext<P>(zext_u32x64(t));
+}
+
+// Reduction policy of wide_classical_bignum with barrett_reduce. Any P whose
+// most significant 32-bit digit is not zero can be used.
+struct barrett_reduction
+{
+  template <concepts::bignum_cst P>
+  static constexpr bool supports = (P::value.cbn()[bn_nlimbs<bn_t<P>>-1] >> 32) != 0;
+
+  template <concepts::bignum_cst P, concepts::wide_bignum WD>
+  static auto reduce(WD const& t) {
+    return details::barrett_reduce_u32_zext<P>(t);
+  }
+};
+
+template <concepts::wide_bignum WBN, concepts::bignum_cst P>
+using wide_barrett_bignum = wide_classical_bignum<WBN, P, barrett_reduction>;
+
+namespace concepts {
+template <class T>
+concept wide_barrett_bignum = wide_classical_bignum<T> &&
+  std::same_as<typename T::reduction_type, barrett_reduction>;
+} // concepts
+
+} // ecsimd
+
+#endif
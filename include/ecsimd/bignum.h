@@ -98,8 +98,12 @@ using bignum_128 = bignum<uint64_t, 2>;
 using bignum_256 = bignum<uint64_t, 4>;
 using bignum_512 = bignum<uint64_t, 8>;
 
-template <class Bignum>
-using wide_bignum = eve::wide<Bignum, eve::fixed<4>>;
+// Number of bignums processed in parallel by default. 4 64-bit lanes fit in
+// an AVX2 register, 8 in an AVX-512 one.
+using default_cardinal = eve::fixed<4>;
+
+template <class Bignum, class Cardinal = default_cardinal>
+using wide_bignum = eve::wide<Bignum, Cardinal>;
 
 namespace concepts {
 template <class T>
@@ -164,7 +168,7 @@ template <concepts::bignum_cst P, std::unsigned_integral LimbType>
 using remap_limb_t = typename remap_limb<P, LimbType>::type;
 
 template <concepts::wide_bignum WBN>
-using wbn_zext_t = wide_bignum<bignum<bn_limb_t<WBN>, bn_nlimbs<WBN>*2>>;
+using wbn_zext_t = wide_bignum<bignum<bn_limb_t<WBN>, bn_nlimbs<WBN>*2>, eve::cardinal_t<WBN>>;
 
 } // ecsimd
 
@@ -0,0 +1,122 @@
+#ifndef ECSIMD_CLASSICAL_FORM_H
+#define ECSIMD_CLASSICAL_FORM_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mgry.h>
+#include <ecsimd/mgry_csts.h>
+#include <ecsimd/modular.h>
+#include <ecsimd/mul.h>
+
+#include <eve/wide.hpp>
+
+#include <concepts>
+#include <cstdint>
+
+namespace ecsimd {
+
+// Field elements stored in classical form (R == 1). Products are computed
+// over 32-bit digits (see mul_u32_zext), and reduced by the Reduction
+// policy, which provides:
+// * supports<P>: whether P can be used with this reduction,
+// * reduce<P>(t): t % P, with t made of 2*ndigits 32-bit digits.
+// See special_form.h and barrett.h.
+template <concepts::wide_bignum WBN, concepts::bignum_cst P, class Reduction>
+struct wide_classical_bignum
+{
+  using wide_bignum_type = WBN;
+  using bignum_type = typename wide_bignum_type::value_type;
+  using P_type = P;
+  using reduction_type = Reduction;
+
+  using constants_type = mgry_constants<wide_bignum_type, P_type>;
+  static_assert(Reduction::template supports<P>);
+
+  wide_classical_bignum() = default;
+
+  wide_classical_bignum(WBN const& n):
+    n_(n)
+  { }
+
+  static wide_classical_bignum R() {
+    return wide_classical_bignum{WBN{bignum_type::from(1)}};
+  }
+
+  static wide_classical_bignum from_classical(WBN const& n) {
+    return wide_classical_bignum{n};
+  }
+
+  WBN to_classical() const {
+    return n_;
+  }
+
+  WBN const& wbn() const { return n_; }
+  WBN& wbn() { return n_; }
+
+private:
+  WBN n_;
+};
+
+namespace concepts {
+template <class T>
+concept wide_classical_bignum = std::same_as<T, wide_classical_bignum<
+  typename T::wide_bignum_type, typename T::P_type, typename T::reduction_type>>;
+} // concepts
+
+template <concepts::wide_classical_bignum WMBN>
+WMBN mgry_add(WMBN const& a, WMBN const& b) {
+  return WMBN{mod_add(a.wbn(), b.wbn(), WMBN::constants_type::wide_P)};
+}
+
+template <concepts::wide_classical_bignum WMBN>
+WMBN mgry_sub(WMBN const& a, WMBN const& b) {
+  return WMBN{mod_sub(a.wbn(), b.wbn(), WMBN::constants_type::wide_P)};
+}
+
+template <concepts::wide_classical_bignum WMBN>
+WMBN mgry_neg(WMBN const& a) {
+  return mgry_sub(WMBN{eve::zero(eve::as(a.wbn()))}, a);
+}
+
+template <size_t Count, concepts::wide_classical_bignum WMBN>
+WMBN mgry_shift_left(WMBN const& a) {
+  static_assert(Count > 0);
+  WMBN ret(mod_shift_left_one(a.wbn(), WMBN::constants_type::wide_P));
+#pragma unroll
+  for (size_t i = 1; i < Count; ++i) {
+    ret.wbn() = mod_shift_left_one(ret.wbn(), WMBN::constants_type::wide_P);
+  }
+  return ret;
+}
+
+template <concepts::wide_classical_bignum WMBN>
+[[gnu::flatten]] WMBN mgry_mul(WMBN const& a, WMBN const& b) {
+  using reduction = typename WMBN::reduction_type;
+  const auto m = mul_u32_zext(zext_u32x64(a.wbn()), zext_u32x64(b.wbn()));
+  return WMBN{reduction::template reduce<typename WMBN::P_type>(m)};
+}
+
+template <concepts::wide_classical_bignum WMBN>
+[[gnu::flatten]] WMBN mgry_sqr(WMBN const& v) {
+  using reduction = typename WMBN::reduction_type;
+  const auto s = square_u32_zext(zext_u32x64(v.wbn()));
+  return WMBN{reduction::template reduce<typename WMBN::P_type>(s)};
+}
+
+template <concepts::wide_classical_bignum WMBN>
+WMBN operator+(WMBN const& a, WMBN const& b) {
+  return mgry_add(a,b);
+}
+
+template <concepts::wide_classical_bignum WMBN>
+WMBN operator-(WMBN const& a, WMBN const& b) {
+  return mgry_sub(a,b);
+}
+
+template <concepts::wide_classical_bignum WMBN>
+WMBN operator*(WMBN const& a, WMBN const& b) {
+  return mgry_mul(a,b);
+}
+
+} // ecsimd
+
+#endif
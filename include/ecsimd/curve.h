@@ -12,7 +12,8 @@ namespace concepts {
 template <class T>
 concept wst_curve_am3 = bignum<typename T::bn_type> &&
   bignum_cst<typename T::P>  && bignum_cst<typename T::B> &&
-  bignum_cst<typename T::Gx> && bignum_cst<typename T::Gy>;
+  bignum_cst<typename T::Gx> && bignum_cst<typename T::Gy> &&
+  bignum_cst<typename T::N>;
 
 // Any possible curve
 template <class T>
@@ -23,11 +24,11 @@ concept curve = wst_curve_am3<T>;
 template <concepts::curve Curve>
 using curve_bn_t = typename Curve::bn_type;
 
-template <concepts::curve Curve>
-using curve_wide_bn_t = wide_bignum<curve_bn_t<Curve>>;
+template <concepts::curve Curve, class Cardinal = default_cardinal>
+using curve_wide_bn_t = wide_bignum<curve_bn_t<Curve>, Cardinal>;
 
-template <concepts::curve Curve>
-using curve_wide_mgry_bn_t = wide_mgry_bignum<curve_wide_bn_t<Curve>, typename Curve::P>;
+template <concepts::curve Curve, class Cardinal = default_cardinal>
+using curve_wide_mgry_bn_t = wide_mgry_bignum<curve_wide_bn_t<Curve, Cardinal>, typename Curve::P>;
 
 } // ecsimd
 
@@ -2,35 +2,43 @@
 #define ECSIMD_CURVE_GROUPE_H
 
 #include <ecsimd/curve.h>
+#include <ecsimd/fixed_base.h>
 #include <ecsimd/mgry_ops.h>
 #include <ecsimd/gfp.h>
+#include <ecsimd/gfp_lazy.h>
 #include <ecsimd/jacobian_curve_point.h>
 #include <ecsimd/swap.h>
 #include <ecsimd/ifelse.h>
+#include <ecsimd/sub.h>
+#include <ecsimd/wnaf.h>
 
+#include <array>
+#include <cstdlib>
 #include <optional>
+#include <span>
 #include <cassert>
 
 #include <iostream>
 
 namespace ecsimd {
 
-template <class>
+// Cardinal is the number of points processed in parallel (e.g. 4 for AVX2,
+// 8 for AVX-512). MgryRepr is the representation of field elements (e.g.
+// wide_mgry_r52 for AVX-512 IFMA).
+template <class, class = default_cardinal,
+          template <class, class> class = wide_field_bignum>
 struct curve_group;
 
-template <concepts::wst_curve_am3 Curve>
-struct curve_group<Curve> {
-  using WBN  = curve_wide_bn_t<Curve>;
+template <concepts::wst_curve_am3 Curve, class Cardinal,
+          template <class, class> class MgryRepr>
+struct curve_group<Curve, Cardinal, MgryRepr> {
+  using WBN  = curve_wide_bn_t<Curve, Cardinal>;
   using BN = typename WBN::value_type;
-  using WMBN = curve_wide_mgry_bn_t<Curve>;
-  using gfp = GFp<WBN, typename Curve::P>;
+  using WJCP = wide_jacobian_curve_point<Curve, Cardinal, MgryRepr>;
+  using gfp = typename WJCP::gfp;
+  using WMBN = typename gfp::WMBN;
 
-  using WCP  = wide_curve_point<Curve>;
-  using WJCP = wide_jacobian_curve_point<Curve>;
-
-  static constexpr auto Bm = to_mgry<typename Curve::P>(Curve::B::value);
-  static constexpr auto Am = to_mgry<typename Curve::P>(Curve::A::value);
-  //static const WMBN Bwm;
+  using WCP  = wide_curve_point<Curve, Cardinal>;
 
   static auto WG() {
     return WCP{WBN{Curve::Gx::value}, WBN{Curve::Gy::value}};
@@ -40,17 +48,25 @@ struct curve_group<Curve> {
     return WJCP::from_affine(WG());
   }
 
+  static gfp A() {
+    return gfp::from_classical(WBN{Curve::A::value});
+  }
+
+  static gfp B() {
+    return gfp::from_classical(WBN{Curve::B::value});
+  }
+
   static std::optional<gfp> compute_y(gfp const& x) {
     // y^2 = x^3 + ax + b
     // a == -3
     const auto xpow3 = x.sqr() * x;
-    const auto x3 = gfp_shift_left<1>(x) + x;
-    const auto ypow2 = xpow3 + gfp{WMBN{WBN{Bm}}} - x3;
+    const auto x3 = gfp_mul_small<3>(x);
+    const auto ypow2 = xpow3 + B() - x3;
     return {ypow2.sqrt()};
   }
 
   static std::optional<WBN> compute_y(WBN const& x) {
-    const auto ret = compute_y(WMBN::from_classical(x));
+    const auto ret = compute_y(gfp::from_classical(x));
     if (!ret) {
       return {};
     }
@@ -58,29 +74,32 @@ struct curve_group<Curve> {
   }
 
   // All the following co-Z Jacobian curve point computations are based on
-  // https://eprint.iacr.org/2010/309.pdf.
+  // https://eprint.iacr.org/2010/309.pdf. Intermediate values are kept in
+  // redundant form (see gfp_lazy.h), and only reduced when stored back into
+  // points. Squares and products minus other values are reduced only once
+  // (see sum_of_products.h).
 
   // Double-with-update (co-Z). P.z must be equal to mgry(1).
   [[gnu::flatten]] static WJCP DBLU(WJCP& P) {
     // TODO: assert z == mgry(1)
-    auto& X1 = P.x();
-    auto& Y1 = P.y();
+    const auto X1 = lazy(P.x());
+    const auto Y1 = lazy(P.y());
 
     const auto B = X1.sqr();
     const auto E = Y1.sqr();
     const auto L = E.sqr();
-    const auto S = gfp_shift_left<1>((X1 + E).sqr() - B - L);
-    const auto M = (gfp_shift_left<1>(B)+B) + gfp{WMBN{WBN{Am}}};
+    const auto S = gfp_mul_small<2>(gfp_sum_of_products(sqr_term(X1 + E), -add_term(B), -add_term(L)));
+    const auto M = gfp_mul_small<3>(B) + lazy(A());
 
     WJCP ret;
-    ret.x() = M.sqr() - gfp_shift_left<1>(S);
-    const auto Lm8 = gfp_shift_left<3>(L);
-    ret.y() = M*(S-ret.x()) - Lm8;
-    ret.z() = gfp_shift_left<1>(Y1);
+    ret.x() = gfp_sum_of_products(sqr_term(M), -add_term(S), -add_term(S));
+    const auto Lm8 = gfp_mul_small<8>(L);
+    ret.y() = gfp_sum_of_products(mul_term(M, S-lazy(ret.x())), -add_term(Lm8));
+    ret.z() = gfp_mul_small<2>(Y1);
 
     // Update P
-    X1 = S;
-    Y1 = Lm8;
+    P.x() = S;
+    P.y() = Lm8;
     P.z() = ret.z();
 
     return ret;
@@ -90,27 +109,26 @@ struct curve_group<Curve> {
   // Z coordinate as the returned point.
   [[gnu::flatten]] static WJCP ZADDU(WJCP& P, WJCP const& O) {
     assert(eve::all(P.z().wbn() == O.z().wbn()));
-    auto& Z = P.z();
-    auto& X1 = P.x();
-    auto& Y1 = P.y();
-    auto const& X2 = O.x();
-    auto const& Y2 = O.y();
+    const auto Z = lazy(P.z());
+    const auto X1 = lazy(P.x());
+    const auto Y1 = lazy(P.y());
+    const auto X2 = lazy(O.x());
+    const auto Y2 = lazy(O.y());
 
     const auto C = (X1-X2).sqr();
     const auto W1 = X1*C;
     const auto W2 = X2*C;
-    const auto D = (Y1-Y2).sqr();
     const auto A1 = Y1*(W1-W2);
 
     WJCP ret;
-    ret.x() = D-W1-W2;
-    ret.y() = (Y1-Y2)*(W1-ret.x())-A1;
+    ret.x() = gfp_sum_of_products(sqr_term(Y1-Y2), -add_term(W1), -add_term(W2));
+    ret.y() = gfp_sum_of_products(mul_term(Y1-Y2, W1-lazy(ret.x())), -add_term(A1));
     ret.z() = Z*(X1-X2);
 
     // Update P
-    X1 = W1;
-    Y1 = A1;
-    Z  = ret.z();
+    P.x() = W1;
+    P.y() = A1;
+    P.z() = ret.z();
 
     return ret;
   }
@@ -119,12 +137,12 @@ struct curve_group<Curve> {
   // same Z than returned point.
   [[gnu::flatten]] static WJCP ZDAU(WJCP const& P, WJCP& Q) {
     assert(eve::all(P.z().wbn() == Q.z().wbn()));
-    const auto& X1 = P.x();
-    const auto& Y1 = P.y();
-    const auto& Z  = P.z();
+    const auto X1 = lazy(P.x());
+    const auto Y1 = lazy(P.y());
+    const auto Z  = lazy(P.z());
 
-    auto& X2 = Q.x();
-    auto& Y2 = Q.y();
+    const auto X2 = lazy(Q.x());
+    const auto Y2 = lazy(Q.y());
 
     const auto Cp = (X1 - X2).sqr();
     const auto W1p = X1*Cp;
@@ -132,21 +150,21 @@ struct curve_group<Curve> {
     const auto Dp = (Y1-Y2).sqr();
     const auto A1p = Y1*(W1p-W2p);
     const auto X3pc = Dp - W1p - W2p;
+    const auto A1p2 = gfp_mul_small<2>(A1p);
     const auto C = (X3pc - W1p).sqr();
-    const auto Y3p = ((Y1-Y2) + (W1p - X3pc)).sqr() - Dp - C - gfp_shift_left<1>(A1p);
-    const auto W1 = gfp_shift_left<2>(X3pc)*C;
-    const auto W2 = gfp_shift_left<2>(W1p)*C;
-    const auto D = (Y3p-gfp_shift_left<1>(A1p)).sqr();
+    const auto Y3p = gfp_sum_of_products(sqr_term((Y1-Y2) + (W1p - X3pc)),
+      -add_term(Dp), -add_term(C), -add_term(A1p2));
+    const auto W1 = gfp_mul_small<4>(X3pc)*C;
+    const auto W2 = gfp_mul_small<4>(W1p)*C;
     const auto A1 = Y3p*(W1-W2);
 
     WJCP ret;
-    ret.x() = D-W1-W2;
-    ret.y() = (Y3p-gfp_shift_left<1>(A1p))*(W1-ret.x()) - A1;
-    ret.z() = Z*((X1-X2+X3pc-W1p).sqr() - Cp - C);
+    ret.x() = gfp_sum_of_products(sqr_term(Y3p-A1p2), -add_term(W1), -add_term(W2));
+    ret.y() = gfp_sum_of_products(mul_term(Y3p-A1p2, W1-lazy(ret.x())), -add_term(A1));
+    ret.z() = Z*gfp_sum_of_products(sqr_term(X1-X2+X3pc-W1p), -add_term(Cp), -add_term(C));
 
-    const auto Dc = (Y3p+gfp_shift_left<1>(A1p)).sqr();
-    X2 = Dc - W1 - W2;
-    Y2 = (Y3p + gfp_shift_left<1>(A1p))*(W1-X2)-A1;
+    Q.x() = gfp_sum_of_products(sqr_term(Y3p+A1p2), -add_term(W1), -add_term(W2));
+    Q.y() = gfp_sum_of_products(mul_term(Y3p+A1p2, W1-lazy(Q.x())), -add_term(A1));
     Q.z() = ret.z();
 
     return ret;
@@ -154,30 +172,49 @@ struct curve_group<Curve> {
 
   static WJCP ADD_Z2_1(WJCP const& A, WJCP const& B) {
     // TODO: assert B.z() == R
-    const auto& X1 = A.x();
-    const auto& Y1 = A.y();
-    const auto& Z1 = A.z();
-    const auto& X2 = B.x();
-    const auto& Y2 = B.y();
+    const auto X1 = lazy(A.x());
+    const auto Y1 = lazy(A.y());
+    const auto Z1 = lazy(A.z());
+    const auto X2 = lazy(B.x());
+    const auto Y2 = lazy(B.y());
 
     const auto Z1Z1 = Z1.sqr();
     const auto U2 = X2*Z1Z1;
     const auto S2 = Y2*Z1*Z1Z1;
     const auto H = U2-X1;
     const auto HH = H.sqr();
-    const auto I = gfp_shift_left<2>(HH);
+    const auto I = gfp_mul_small<4>(HH);
     const auto J = H*I;
-    const auto r = gfp_shift_left<1>(S2-Y1);
+    const auto r = gfp_mul_small<2>(S2-Y1);
     const auto V = X1*I;
 
     WJCP ret;
-    ret.x() = r.sqr()-J-gfp_shift_left<1>(V);
-    ret.y() = r*(V-ret.x())-gfp_shift_left<1>(Y1)*J;
-    ret.z() = (Z1+H).sqr()-Z1Z1-HH;
+    ret.x() = gfp_sum_of_products(sqr_term(r), -add_term(J), -add_term(V), -add_term(V));
+    ret.y() = gfp_sum_of_products(mul_term(r, V-lazy(ret.x())), -mul_term(gfp_mul_small<2>(Y1), J));
+    ret.z() = gfp_sum_of_products(sqr_term(Z1+H), -add_term(Z1Z1), -add_term(HH));
 
     return ret;
   }
 
+  // Jacobian doubling, for any Z (dbl-2001-b from
+  // https://hyperelliptic.org/EFD/g1p/auto-shortw-jacobian-3.html)
+  [[gnu::flatten]] static WJCP DBL(WJCP const& P) {
+    const auto X1 = lazy(P.x());
+    const auto Y1 = lazy(P.y());
+    const auto Z1 = lazy(P.z());
+
+    const auto delta = Z1.sqr();
+    const auto gamma = Y1.sqr();
+    const auto beta4 = gfp_mul_small<4>(X1*gamma);
+    const auto alpha = gfp_mul_small<3>((X1-delta)*(X1+delta));
+
+    WJCP ret;
+    ret.x() = gfp_sum_of_products(sqr_term(alpha), -add_term(beta4), -add_term(beta4));
+    ret.y() = gfp_sum_of_products(mul_term(alpha, beta4-lazy(ret.x())), -mul_term(gfp_mul_small<8>(gamma), gamma));
+    ret.z() = gfp_sum_of_products(sqr_term(Y1+Z1), -add_term(gamma), -add_term(delta));
+    return ret;
+  }
+
   // Co-Z point triple. Returns 3*P, and updates P to get the same Z coordinate
   // as the returned point.
   static WJCP TRPLU(WJCP& P) {
@@ -185,7 +222,7 @@ struct curve_group<Curve> {
     return ZADDU(P, dbl);
   }
 
-  // Scalar multiplication, 4 scalars x 4 points
+  // Scalar multiplication, one scalar per point
   static WJCP scalar_mult(WBN const& x, WJCP P) {
     using limb_t = bn_limb_t<WBN>;
     using wide_limb_t = eve::wide<limb_t, eve::cardinal_t<WBN>>;
@@ -217,7 +254,7 @@ struct curve_group<Curve> {
     return if_else(meven, Psub, P);
   }
 
-  // Scalar multiplication, 1 scalar x 4 points
+  // Scalar multiplication, the same scalar for all points
   static WJCP scalar_mult_1s(BN const& x, WJCP P) {
     using limb_t = bn_limb_t<WBN>;
     using wide_limb_t = eve::wide<limb_t, eve::cardinal_t<WBN>>;
@@ -249,10 +286,169 @@ struct curve_group<Curve> {
     *R[xbit] = ADD_Z2_1(*R[0], oppP);
     return *R[0];
   }
-};
 
-//template <concepts::wst_curve_am3 Curve>
-//const curve_wide_mgry_bn_t<Curve> curve_group<Curve>::Bwm = curve_wide_mgry_bn_t<Curve>{curve_wide_bn_t<Curve>{curve_group<Curve>::Bm}};
+  // Scalar multiplication, one scalar per point, in variable time: x must be
+  // public (e.g. for signature verification), and in [1,n-1]. P.z must be
+  // equal to mgry(1).
+  // x is recoded in width-W NAF (see wnaf.h), and the odd multiples of P are
+  // precomputed in affine coordinates. The loop doubles once per bit, and
+  // adds the selected multiple on the lanes with a non-zero digit. Bits
+  // where all the digits are zero skip the addition.
+  static WJCP scalar_mult_vartime(WBN const& x, WJCP const& P) {
+    using limb_t = bn_limb_t<WBN>;
+    using wide_limb_t = eve::wide<limb_t, eve::cardinal_t<WBN>>;
+    constexpr size_t W = 5;
+    constexpr size_t card = eve::cardinal_t<WBN>::value;
+    constexpr size_t ndigits = bn_nlimbs<WBN>*std::numeric_limits<limb_t>::digits + 1;
+    constexpr size_t row_size = size_t{1} << (W-2);
+
+    // (2j+1)*P, as in compute_base_table
+    std::array<WJCP, row_size> T;
+    T[0] = P;
+    auto D = DBLU(T[0]);
+    for (size_t j = 1; j < row_size; ++j) {
+      T[j] = ZADDU(D, T[j-1]);
+    }
+    WJCP::batch_normalize(T);
+
+    std::array<std::array<int8_t, ndigits>, card> digits;
+    for (size_t l = 0; l < card; ++l) {
+      digits[l] = bn_wnaf<W>(x.get(l));
+    }
+    size_t top = 0;
+    for (size_t l = 0; l < card; ++l) {
+      for (size_t i = ndigits; i-- > top;) {
+        if (digits[l][i] != 0) {
+          top = i;
+          break;
+        }
+      }
+    }
+
+    const auto wzero = eve::zero(eve::as<wide_limb_t>());
+    // Lanes whose accumulator is still the point at infinity
+    auto inf = wzero == wzero;
+    WJCP ret = T[0];
+    for (size_t i = top+1; i-- > 0;) {
+      ret = DBL(ret);
+
+      bool any = false;
+      for (size_t l = 0; l < card; ++l) {
+        any |= digits[l][i] != 0;
+      }
+      if (!any) {
+        continue;
+      }
+      const auto absd = wide_limb_t{[&](auto l, auto) { return limb_t(std::abs(digits[l][i])); }};
+      const auto sign = wide_limb_t{[&](auto l, auto) { return limb_t(digits[l][i] < 0); }};
+      const auto nz = absd != wzero;
+      const auto neg = sign != wzero;
+      const auto j = absd >> 1;
+
+      // Masked read of T[j], for each lane
+      WJCP Q = T[0];
+      for (size_t e = 1; e < row_size; ++e) {
+        Q = if_else(j == wide_limb_t{limb_t(e)}, T[e], Q);
+      }
+      auto oppy = Q.y().opposite();
+      Q.y() = if_else(neg, oppy, Q.y());
+
+      auto sum = ADD_Z2_1(ret, Q);
+      ret = if_else(nz && !inf, sum, ret);
+      ret = if_else(nz && inf, Q, ret);
+      inf = inf && !nz;
+    }
+    return ret;
+  }
+
+  // Fixed-base scalar multiplication (see fixed_base.h). With 6-bit windows,
+  // the P-256 table has 43 rows of 32 points (88KB with 64-bit limbs). 7-bit
+  // windows are only ~10% faster, for twice the memory.
+  static constexpr size_t base_window = 6;
+  static constexpr size_t base_rows =
+    (bn_nlimbs<WBN>*std::numeric_limits<bn_limb_t<WBN>>::digits + base_window - 1) / base_window;
+  using base_table_type = fixed_base_table<
+    typename WMBN::wide_bignum_type::value_type, base_window, base_rows>;
+
+  // Table of multiples of G, computed at first use
+  static base_table_type const& base_table() {
+    static const base_table_type table = compute_base_table();
+    return table;
+  }
+
+  static base_table_type compute_base_table() {
+    constexpr auto row_size = base_table_type::row_size;
+    const auto store = [](auto& e, WJCP const& P) {
+      e.x = P.x().wbn().get(0);
+      e.y = P.y().wbn().get(0);
+    };
+
+    base_table_type ret;
+    // B = 2**(W*i)*G, with Z == 1
+    WJCP B = WJG();
+    std::array<WJCP, row_size> T;
+    for (size_t i = 0; i < base_rows; ++i) {
+      // (2j+1)*B = 2*B + (2j-1)*B, with co-Z additions
+      T[0] = B;
+      auto D = DBLU(T[0]);
+      for (size_t j = 1; j < row_size; ++j) {
+        T[j] = ZADDU(D, T[j-1]);
+      }
+      WJCP::batch_normalize(T);
+      for (size_t j = 0; j < row_size; ++j) {
+        store(ret.rows[i][j], T[j]);
+      }
+      // 2**W*B = (2**W-1)*B + B
+      B = ADD_Z2_1(T[row_size-1], T[0]);
+      WJCP::batch_normalize(std::span{&B, 1});
+    }
+    store(ret.top, B);
+    return ret;
+  }
+
+  // Scalar multiplication of G, one scalar per point. x must be in [1,n-1].
+  // Each lane reads the whole table, and performs the same sequence of
+  // mixed additions. These are not complete: a few specific scalars (whose
+  // partial sums reach +/- the next added point modulo n) give a wrong
+  // result, as for scalar_mult.
+  static WJCP scalar_mult_base(WBN const& x) {
+    using limb_t = bn_limb_t<WBN>;
+    using wide_limb_t = eve::wide<limb_t, eve::cardinal_t<WBN>>;
+    using WRBN = typename WMBN::wide_bignum_type;
+    auto const& table = base_table();
+
+    // The recoding needs an odd scalar: use n-x for even ones, and negate
+    // the result.
+    const auto wlsb = wide_limb_t{limb_t{1U}};
+    const auto meven = (eve::get<0>(x) & wlsb) == eve::zero(eve::as<wide_limb_t>());
+    const auto k = if_else(meven, sub_no_carry(WBN{Curve::N::value}, x), x);
+
+    const auto lookup = [&](size_t i) {
+      const auto [j, neg] = details::signed_window_digit<base_window>(k, i);
+      const auto [px, py] = details::fixed_base_lookup<WRBN>(table.rows[i], j);
+      WJCP ret;
+      ret.x().wbn() = px;
+      ret.y().wbn() = py;
+      auto oppy = ret.y().opposite();
+      ret.y() = if_else(neg, oppy, ret.y());
+      ret.z() = gfp::one();
+      return ret;
+    };
+
+    auto ret = lookup(0);
+    for (size_t i = 1; i < base_rows; ++i) {
+      ret = ADD_Z2_1(ret, lookup(i));
+    }
+    WJCP top;
+    top.x().wbn() = WRBN{table.top.x};
+    top.y().wbn() = WRBN{table.top.y};
+    top.z() = gfp::one();
+    ret = ADD_Z2_1(ret, top);
+
+    auto oppret = ret.opposite();
+    return if_else(meven, oppret, ret);
+  }
+};
 
 } // ecsimd
 
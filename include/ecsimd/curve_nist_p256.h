@@ -29,6 +29,10 @@ struct curve_nist_p256 {
   struct Gy {
     static constexpr auto value = bn_from_bytes_BE<bn_type>("4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5"_hex);
   };
+  // Order of G
+  struct N {
+    static constexpr auto value = bn_from_bytes_BE<bn_type>("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551"_hex);
+  };
 };
 
 static_assert(concepts::wst_curve_am3<curve_nist_p256>);
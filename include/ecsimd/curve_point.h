@@ -10,12 +10,13 @@
 
 namespace ecsimd {
 
-template <concepts::curve Curve>
+template <concepts::curve Curve, class Cardinal = default_cardinal>
 struct wide_curve_point
 {
   using curve_type = Curve;
+  using cardinal_type = Cardinal;
   using bignum_type = typename curve_type::bn_type;
-  using WBN = wide_bignum<bignum_type>;
+  using WBN = wide_bignum<bignum_type, Cardinal>;
 
   wide_curve_point() = default;
   wide_curve_point(wide_curve_point const&) = default;
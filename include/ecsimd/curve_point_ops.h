@@ -9,9 +9,9 @@
 
 namespace ecsimd {
 
-template <concepts::curve Curve>
-std::optional<wide_curve_point<Curve>> wide_curve_point<Curve>::from_x(typename wide_curve_point<Curve>::WBN const& x) {
-  const auto y = curve_group<Curve>::compute_y(x);
+template <concepts::curve Curve, class Cardinal>
+std::optional<wide_curve_point<Curve, Cardinal>> wide_curve_point<Curve, Cardinal>::from_x(typename wide_curve_point<Curve, Cardinal>::WBN const& x) {
+  const auto y = curve_group<Curve, Cardinal>::compute_y(x);
   if (!y) {
     return {};
   }
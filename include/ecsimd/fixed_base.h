@@ -0,0 +1,84 @@
+#ifndef ECSIMD_FIXED_BASE_H
+#define ECSIMD_FIXED_BASE_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/ifelse.h>
+#include <ecsimd/mgry_ops.h>
+
+#include <eve/wide.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace ecsimd {
+
+// Fixed-base scalar multiplication, with signed windows of W bits. An odd
+// scalar k of N bits is recoded as:
+//
+//   k = sum(d[i]*2**(W*i), i < R) + 2**(W*R), with R = ceil(N/W)
+//
+// where every digit d[i] is odd and in [-(2**W-1), 2**W-1] (Joye-Tunstall
+// regular recoding). As no digit is zero, k*G is always the sum of R+1
+// precomputed points, and no doubling is needed: row i of the table holds the
+// affine points (2j+1)*2**(W*i)*G for j < 2**(W-1), and top is 2**(W*R)*G.
+// The negative digits are handled by negating the y coordinate of the
+// selected point.
+template <concepts::bignum RBN, size_t W, size_t Rows>
+struct fixed_base_table
+{
+  static_assert(W >= 2 && W < 8);
+  static constexpr size_t window = W;
+  static constexpr size_t nrows = Rows;
+  static constexpr size_t row_size = size_t{1} << (W-1);
+
+  // Affine coordinates, in the representation of the field elements
+  struct point {
+    RBN x;
+    RBN y;
+  };
+  using row_type = std::array<point, row_size>;
+
+  std::array<row_type, Rows> rows;
+  point top;
+};
+
+namespace details {
+
+// Digit i of the recoding of the odd scalar k, for each lane. It is computed
+// from the W+1 bits of k starting at W*i, with the least significant one
+// forced to 1: d = v - 2**W. Returns the index j of |d| = 2j+1 in the row,
+// and the lanes where d is negative.
+template <size_t W, concepts::wide_bignum WBN>
+static auto signed_window_digit(WBN const& k, size_t i) {
+  using limb_type = bn_limb_t<WBN>;
+  using WL = eve::wide<limb_type, eve::cardinal_t<WBN>>;
+  const WL v = wbn_window<W+1>(k, W*i) | WL{limb_type{1}};
+  const WL hi = v >> W;
+  const auto neg = hi == eve::zero(eve::as<WL>());
+  // If d < 0, |d|-1 = 2**W-1-v, which is v ^ (2**W-1)
+  const WL absd = (v ^ (hi - WL{limb_type{1}})) & WL{(limb_type{1} << W) - 1};
+  return std::make_pair(absd >> 1, neg);
+}
+
+// row[j[l]] for each lane l. Every entry is read, so that the memory access
+// pattern does not depend on j.
+template <concepts::wide_bignum WRBN, class Row, class WL>
+static auto fixed_base_lookup(Row const& row, WL const& j) {
+  using limb_type = typename WL::value_type;
+  WRBN x{row[0].x};
+  WRBN y{row[0].y};
+  for (size_t e = 1; e < row.size(); ++e) {
+    const auto mask = j == WL{limb_type(e)};
+    x = if_else(mask, WRBN{row[e].x}, x);
+    y = if_else(mask, WRBN{row[e].y}, y);
+  }
+  return std::make_pair(x, y);
+}
+
+} // details
+
+} // ecsimd
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef ECSIMD_GFN_H
+#define ECSIMD_GFN_H
+
+#include <ecsimd/curve.h>
+#include <ecsimd/gfp.h>
+
+namespace ecsimd {
+
+// Scalar field of a curve, i.e. integers modulo the order N of its
+// generator. Hashes are reduced with GFn::from_classical_wide.
+template <concepts::curve Curve, class Cardinal = default_cardinal,
+          template <class, class> class MgryRepr = wide_field_bignum>
+using GFn = GFp<curve_wide_bn_t<Curve, Cardinal>, typename Curve::N,
+                MgryRepr<curve_wide_bn_t<Curve, Cardinal>, typename Curve::N>>;
+
+template <concepts::curve Curve, class Cardinal = default_cardinal>
+using curve_wide_hash_t = wbn_zext_t<curve_wide_bn_t<Curve, Cardinal>>;
+
+} // ecsimd
+
+#endif
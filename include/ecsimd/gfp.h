@@ -1,26 +1,53 @@
 #ifndef ECSIMD_GFP_H
 #define ECSIMD_GFP_H
 
+#include <ecsimd/addchain.h>
+#include <ecsimd/barrett.h>
 #include <ecsimd/bignum.h>
+#include <ecsimd/ifelse.h>
 #include <ecsimd/mgry.h>
 #include <ecsimd/mgry_ops.h>
+#include <ecsimd/mul_small.h>
+#include <ecsimd/safegcd.h>
+#include <ecsimd/shift.h>
+#include <ecsimd/special_form.h>
+#include <ecsimd/sum_of_products.h>
 
+#include <eve/function/all.hpp>
 #include <eve/function/any.hpp>
+#include <eve/function/if_else.hpp>
 
 #include <ctbignum/addition.hpp>
 #include <ctbignum/division.hpp>
 
+#include <bit>
 #include <optional>
+#include <span>
+#include <utility>
+#include <vector>
 
 namespace ecsimd {
 
-template <concepts::wide_bignum WBN_, concepts::bignum_cst P>
+// fermat computes x**(p-2), with a fixed addition chain if one exists for p
+// (see addchain.h) and mgry_pow otherwise. safegcd uses the constant-time
+// divstep algorithm of safegcd.h on the classical representation.
+enum class inversion_strategy {
+  fermat,
+  safegcd
+};
+
+// WMBN_ is the representation of field elements in the Montgomery domain. WBN_
+// is always the type of classical numbers (see from_classical/to_classical).
+// By default, primes of special form use a dedicated reduction (with R == 1,
+// see special_form.h).
+template <concepts::wide_bignum WBN_, concepts::bignum_cst P,
+          concepts::mgry_repr WMBN_ = wide_field_bignum<WBN_, P>>
 struct GFp
 {
   using P_type = P;
   using WBN = WBN_;
   using BN = typename WBN::value_type;
-  using WMBN = wide_mgry_bignum<WBN, P>;
+  using WMBN = WMBN_;
 
   GFp() = default;
   GFp(WMBN const& n):
@@ -39,28 +66,111 @@ struct GFp
     return n_.to_classical();
   }
 
+  // Reduces a number twice as large as p (e.g. a 512-bit hash for a 256-bit
+  // modulus): n = hi*2**k + lo, with k the number of bits of BN, or directly
+  // with barrett_reduce for the Barrett representation
+  static GFp from_classical_wide(wbn_zext_t<WBN> const& n) {
+    if constexpr (concepts::wide_barrett_bignum<WMBN>) {
+      return GFp{WMBN{barrett_reduce<P>(n)}};
+    }
+    else {
+      WBN lo;
+      eve::detail::for_<0,1,bn_nlimbs<WBN>>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+        constexpr auto i = decltype(i_)::value;
+        eve::get<i>(lo) = eve::get<i>(n);
+      });
+      const WBN hi = limb_shift_right<bn_nlimbs<WBN>>(n);
+      return from_classical(hi) * from_classical(WBN{P_two_k}) + from_classical(lo);
+    }
+  }
+
+  template <inversion_strategy S = inversion_strategy::safegcd>
   GFp inverse() const {
-    return {mgry_pow(n_, P_pow_m2)};
+    if constexpr (S == inversion_strategy::fermat) {
+      if constexpr (addition_chain<P>::available) {
+        return addition_chain<P>::inverse(*this);
+      }
+      else {
+        return {mgry_pow(n_, P_pow_m2)};
+      }
+    }
+    else {
+      return from_classical(safegcd_inverse<P>(to_classical()));
+    }
   }
 
+  // Inverts every element of v in place with Montgomery's trick: one
+  // inversion and 3(n-1) multiplications. Zero lanes are replaced by one in
+  // the products and set back to zero, so that they do not spoil the other
+  // elements.
+  template <inversion_strategy S = inversion_strategy::safegcd>
+  static void batch_inverse(std::span<GFp> v) {
+    const size_t n = v.size();
+    if (n == 0) {
+      return;
+    }
+    const auto one = GFp::one();
+    auto zero = one;
+    zero.wbn() = eve::zero(eve::as(zero.wbn()));
+    auto is_zero = [](GFp const& a) {
+      return a.wbn() == eve::zero(eve::as(a.wbn()));
+    };
+
+    std::vector<GFp> prods(n);
+    prods[0] = if_else(is_zero(v[0]), one, v[0]);
+    for (size_t i = 1; i < n; ++i) {
+      prods[i] = prods[i-1] * if_else(is_zero(v[i]), one, v[i]);
+    }
+
+    auto inv = prods[n-1].template inverse<S>();
+    for (size_t i = n-1; i > 0; --i) {
+      const auto vzero = is_zero(v[i]);
+      const auto vinv = inv * prods[i-1];
+      inv = inv * if_else(vzero, one, v[i]);
+      v[i] = if_else(vzero, zero, vinv);
+    }
+    v[0] = if_else(is_zero(v[0]), zero, inv);
+  }
+
+  // Legendre symbol of each lane with Euler's criterion: 1, -1, or 0 for
+  // zero. It costs as much as sqrt_lanes, which also tells the non residues
+  // apart.
+  auto legendre() const {
+    using WS = eve::wide<int64_t, eve::cardinal_t<WBN>>;
+    using LS = eve::logical<WS>;
+    const auto e = pow_euler().wbn();
+    return eve::if_else(std::bit_cast<LS>(e == one().wbn()), WS{1},
+      eve::if_else(std::bit_cast<LS>(e == eve::zero(eve::as(e))), eve::zero(eve::as<WS>()), WS{-1}));
+  }
+
+  // Returns nothing if any lane has no square root
   std::optional<GFp> sqrt() const {
-    const auto ret = GFp{mgry_pow(n_, P_pow_sqrt)};
-    // TODO: verify it exists using the Jacobi symbol
-    // (https://en.wikipedia.org/wiki/Jacobi_symbol#Calculating_the_Jacobi_symbol)
+    const auto ret = pow_sqrt();
     if (eve::any(ret.sqr().wbn() != wbn())) {
       return {};
     }
     return {ret};
   }
 
+  // Lane-wise square root: returns the roots, and the mask of the lanes for
+  // which they exist (the other lanes hold unspecified values)
+  auto sqrt_lanes() const {
+    const auto ret = pow_sqrt();
+    return std::make_pair(ret, ret.sqr().wbn() == wbn());
+  }
+
   GFp sqr() const {
     return {mgry_sqr(n_)};
   }
 
+  // this**(2**N)
+  template <size_t N>
+  GFp sqr_n() const {
+    return {mgry_sqr_n<N>(n_)};
+  }
+
   GFp opposite() const {
-    using constants_type = typename WMBN::constants_type;
-    WMBN ret = mgry_sub(n_, WMBN::R());
-    return GFp{mgry_sub(WMBN{WBN{constants_type::Pm1_by_R_p}}, ret)};
+    return GFp{mgry_neg(n_)};
   }
 
   auto operator<=>(GFp const& o) const {
@@ -76,22 +186,48 @@ struct GFp
 private:
   using cbn_type = typename BN::cbn_type;
 
+  GFp pow_sqrt() const {
+    // See https://www.rieselprime.de/ziki/Modular_square_root
+    static_assert((P_cbn[0] & 3) == 3);
+    if constexpr (addition_chain<P>::available) {
+      return addition_chain<P>::sqrt(*this);
+    }
+    else {
+      return {mgry_pow(n_, P_pow_sqrt)};
+    }
+  }
+
+  // this**((p-1)/2)
+  GFp pow_euler() const {
+    if constexpr (addition_chain<P>::available) {
+      return addition_chain<P>::euler(*this);
+    }
+    else {
+      return {mgry_pow(n_, P_pow_euler)};
+    }
+  }
+
   static constexpr auto P_cbn = P::value.cbn();
   static constexpr auto P_pow_m2 = BN::from(cbn::subtract_ignore_carry(
       P_cbn,cbn_type{2}));
-  // See https://www.rieselprime.de/ziki/Modular_square_root
-  // P % 4 == 3
-  static_assert((P_cbn[0] & 3) == 3);
+  static constexpr auto P_pow_euler = BN::from(cbn::shift_right(P_cbn, 1));
+  // Only used if P % 4 == 3
   static constexpr auto P_pow_sqrt = BN::from(
     cbn::detail::first<bn_nlimbs<BN>>(
       cbn::shift_right(P_cbn+cbn_type{1},2)));
+  // 2**k % p, with k the number of bits of BN
+  static constexpr auto P_two_k = []() {
+    cbn::big_int<bn_nlimbs<BN>+1, bn_limb_t<BN>> v{};
+    v[bn_nlimbs<BN>] = 1;
+    return BN::from(cbn::div(v, P_cbn).remainder);
+  }();
 
   WMBN n_;
 };
 
 namespace concepts {
 template <class T>
-concept GFp = std::same_as<T, GFp<typename T::WBN, typename T::P_type>>;
+concept GFp = std::same_as<T, GFp<typename T::WBN, typename T::P_type, typename T::WMBN>>;
 } // concepts
 
 template <concepts::GFp GFP>
@@ -109,11 +245,35 @@ GFP operator*(GFP const& a, GFP const& b) {
   return GFP{mgry_mul(a.wmbn(),b.wmbn())};
 }
 
+// For each lane, a if mask else b (see ifelse.h)
+template <concepts::GFp GFP>
+auto if_else(cmp_res_t<typename GFP::WBN> const& mask, GFP const& a, GFP const& b)
+{
+  return GFP{if_else(mask, a.wmbn(), b.wmbn())};
+}
+
 template <size_t Count, concepts::GFp GFP>
 GFP gfp_shift_left(GFP const& a) {
   return GFP{mgry_shift_left<Count>(a.wmbn())};
 }
 
+// K*a, with a single reduction (see mgry_mul_small)
+template <uint64_t K, concepts::GFp GFP>
+GFP gfp_mul_small(GFP const& a) {
+  return GFP{mgry_mul_small<K>(a.wmbn())};
+}
+
+// Sum of products of field elements, with a single reduction (see
+// mgry_sum_of_products), e.g. gfp_sum_of_products(mul_term(a, b), -add_term(c))
+template <concepts::sop_term T0, concepts::sop_term... Ts>
+  requires concepts::GFp<typename T0::a_type>
+auto gfp_sum_of_products(T0 const& t0, Ts const&... ts) {
+  using GFP = typename T0::a_type;
+  auto to_wmbn = [](auto const& v) { return v.wmbn(); };
+  return GFP{mgry_sum_of_products(details::sop_transform(t0, to_wmbn),
+    details::sop_transform(ts, to_wmbn)...)};
+}
+
 } // ecsimd
 
 #endif
@@ -0,0 +1,202 @@
+#ifndef ECSIMD_GFP_LAZY_H
+#define ECSIMD_GFP_LAZY_H
+
+#include <ecsimd/gfp.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ecsimd {
+
+// Elements of GF(p) in redundant form: GFp_lazy<GFP, Bound> holds a value
+// in [0, Bound*p). The bound is tracked at compile time, so that reductions
+// are only done when the result of an operation could not be stored in the
+// underlying representation anymore, and when converting back to GFP.
+//
+// Representations with spare bits expose lazy_max_bound (the largest B such
+// that B*p < R), and mgry_{add,sub,shift_left,mul,reduce}_lazy (see for
+// instance mgry_r52.h). Their lazy multiplication must be an almost
+// Montgomery multiplication, i.e. return a value < a*b/R + p. Other
+// representations (like wide_mgry_bignum) have lazy_max_bound == 1, and
+// GFp_lazy then performs exactly the same operations as GFp.
+
+namespace details {
+template <class WMBN>
+constexpr size_t lazy_max_bound() {
+  if constexpr (requires { WMBN::lazy_max_bound; }) {
+    return WMBN::lazy_max_bound;
+  }
+  else {
+    return 1;
+  }
+}
+
+// Bound of a lazy multiplication of values < Ba*p and < Bb*p
+constexpr size_t lazy_mul_bound(size_t Ba, size_t Bb, size_t MaxBound) {
+  return (Ba*Bb + MaxBound - 1)/MaxBound + 1;
+}
+} // details
+
+template <concepts::GFp GFP, size_t Bound = 1>
+struct GFp_lazy
+{
+  using gfp_type = GFP;
+  using WMBN = typename GFP::WMBN;
+
+  static constexpr size_t bound = Bound;
+  static constexpr size_t max_bound = details::lazy_max_bound<WMBN>();
+  static_assert(Bound >= 1 && Bound <= max_bound);
+
+  GFp_lazy() = default;
+
+  GFp_lazy(GFP const& v) requires(Bound == 1):
+    n_(v.wmbn())
+  { }
+
+  explicit GFp_lazy(WMBN const& n):
+    n_(n)
+  { }
+
+  GFP reduce() const {
+    if constexpr (Bound == 1) {
+      return GFP{n_};
+    }
+    else {
+      return GFP{mgry_reduce_lazy<Bound>(n_)};
+    }
+  }
+
+  operator GFP() const { return reduce(); }
+
+  auto sqr() const;
+
+  auto const& wmbn() const { return n_; }
+
+private:
+  WMBN n_;
+};
+
+namespace concepts {
+template <class T>
+concept GFp_lazy = std::same_as<T, GFp_lazy<typename T::gfp_type, T::bound>>;
+} // concepts
+
+template <concepts::GFp GFP>
+GFp_lazy<GFP> lazy(GFP const& v) {
+  return {v};
+}
+
+template <concepts::GFp GFP, size_t Ba, size_t Bb>
+auto operator+(GFp_lazy<GFP, Ba> const& a, GFp_lazy<GFP, Bb> const& b) {
+  constexpr auto max_bound = GFp_lazy<GFP>::max_bound;
+  if constexpr (Ba + Bb <= max_bound) {
+    return GFp_lazy<GFP, Ba+Bb>{mgry_add_lazy(a.wmbn(), b.wmbn())};
+  }
+  else if constexpr (Ba == 1 && Bb == 1) {
+    return lazy(a.reduce() + b.reduce());
+  }
+  else if constexpr (Ba >= Bb) {
+    return lazy(a.reduce()) + b;
+  }
+  else {
+    return a + lazy(b.reduce());
+  }
+}
+
+template <concepts::GFp GFP, size_t Ba, size_t Bb>
+auto operator-(GFp_lazy<GFP, Ba> const& a, GFp_lazy<GFP, Bb> const& b) {
+  constexpr auto max_bound = GFp_lazy<GFP>::max_bound;
+  if constexpr (Ba + Bb <= max_bound) {
+    return GFp_lazy<GFP, Ba+Bb>{mgry_sub_lazy<Bb>(a.wmbn(), b.wmbn())};
+  }
+  else if constexpr (Ba == 1 && Bb == 1) {
+    return lazy(a.reduce() - b.reduce());
+  }
+  else if constexpr (Ba >= Bb) {
+    return lazy(a.reduce()) - b;
+  }
+  else {
+    return a - lazy(b.reduce());
+  }
+}
+
+template <concepts::GFp GFP, size_t Ba, size_t Bb>
+auto operator*(GFp_lazy<GFP, Ba> const& a, GFp_lazy<GFP, Bb> const& b) {
+  constexpr auto max_bound = GFp_lazy<GFP>::max_bound;
+  if constexpr (max_bound == 1) {
+    return lazy(a.reduce() * b.reduce());
+  }
+  else if constexpr (details::lazy_mul_bound(Ba, Bb, max_bound) <= max_bound) {
+    constexpr auto bound = details::lazy_mul_bound(Ba, Bb, max_bound);
+    return GFp_lazy<GFP, bound>{mgry_mul_lazy(a.wmbn(), b.wmbn())};
+  }
+  else if constexpr (Ba >= Bb) {
+    return lazy(a.reduce()) * b;
+  }
+  else {
+    return a * lazy(b.reduce());
+  }
+}
+
+template <concepts::GFp GFP, size_t Ba, size_t Bb>
+auto operator==(GFp_lazy<GFP, Ba> const& a, GFp_lazy<GFP, Bb> const& b) {
+  return a.reduce().wbn() == b.reduce().wbn();
+}
+
+template <concepts::GFp GFP, size_t Bound>
+auto GFp_lazy<GFP, Bound>::sqr() const {
+  return *this * *this;
+}
+
+template <size_t Count, concepts::GFp_lazy GFPL>
+auto gfp_shift_left(GFPL const& a) {
+  using GFP = typename GFPL::gfp_type;
+  constexpr auto bound = GFPL::bound << Count;
+  if constexpr (bound <= GFPL::max_bound) {
+    return GFp_lazy<GFP, bound>{mgry_shift_left_lazy<Count>(a.wmbn())};
+  }
+  else if constexpr (GFPL::bound == 1) {
+    return lazy(gfp_shift_left<Count>(a.reduce()));
+  }
+  else {
+    return gfp_shift_left<Count>(lazy(a.reduce()));
+  }
+}
+
+// K*a. Lazy representations only shift and add while the bound allows it,
+// the other ones use the single reduction kernel of gfp_mul_small.
+template <uint64_t K, concepts::GFp_lazy GFPL>
+auto gfp_mul_small(GFPL const& a) {
+  static_assert(K >= 1);
+  if constexpr (K == 1) {
+    return a;
+  }
+  else if constexpr (K*GFPL::bound > GFPL::max_bound) {
+    return lazy(gfp_mul_small<K>(a.reduce()));
+  }
+  else if constexpr (K % 2 == 0) {
+    return gfp_shift_left<1>(gfp_mul_small<K/2>(a));
+  }
+  else {
+    return gfp_mul_small<K-1>(a) + a;
+  }
+}
+
+// Representations without spare bits compute the sum with a single
+// reduction, the lazy ones chain their lazy operations.
+template <concepts::sop_term T0, concepts::sop_term... Ts>
+  requires concepts::GFp_lazy<typename T0::a_type>
+auto gfp_sum_of_products(T0 const& t0, Ts const&... ts) {
+  if constexpr (T0::a_type::max_bound == 1) {
+    auto reduce = [](auto const& v) { return v.reduce(); };
+    return lazy(gfp_sum_of_products(details::sop_transform(t0, reduce),
+      details::sop_transform(ts, reduce)...));
+  }
+  else {
+    return details::sop_chain(t0, ts...);
+  }
+}
+
+} // ecsimd
+
+#endif
@@ -3,7 +3,6 @@
 
 #include <ecsimd/bignum.h>
 #include <ecsimd/mgry.h>
-#include <ecsimd/jacobian_curve_point.h>
 
 #include <eve/function/if_else.hpp>
 
@@ -11,9 +10,11 @@
 
 namespace ecsimd {
 
-// For each bignum at idx i, return a[i] if mask[i] else b[i]
+// For each bignum at idx i, return a[i] if mask[i] else b[i]. The overloads
+// for GFp and points are next to these types (see gfp.h and
+// jacobian_curve_point.h).
 template <concepts::wide_bignum WBN>
-auto if_else(cmp_res_t<WBN> mask, WBN& a, WBN& b)
+auto if_else(cmp_res_t<WBN> const& mask, WBN const& a, WBN const& b)
 {
   WBN ret;
   eve::detail::for_<0,1,bn_nlimbs<WBN>>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
@@ -23,31 +24,12 @@ auto if_else(cmp_res_t<WBN> mask, WBN& a, WBN& b)
   return ret;
 }
 
-template <concepts::wide_mgry_bignum WMBN>
-auto if_else(cmp_res_t<typename WMBN::wide_bignum_type> mask, WMBN& a, WMBN& b)
+template <concepts::mgry_repr WMBN>
+auto if_else(cmp_res_t<typename WMBN::wide_bignum_type> const& mask, WMBN const& a, WMBN const& b)
 {
   return WMBN{if_else(mask, a.wbn(), b.wbn())};
 }
 
-template <concepts::GFp GFP>
-auto if_else(cmp_res_t<typename GFP::WBN> mask, GFP& a, GFP& b)
-{
-  return GFP{if_else(mask, a.wbn(), b.wbn())};
-}
-
-template <concepts::curve Curve>
-auto if_else(
-    cmp_res_t<curve_wide_bn_t<Curve>> mask,
-    wide_jacobian_curve_point<Curve>& A,
-    wide_jacobian_curve_point<Curve>& B)
-{
-  wide_jacobian_curve_point<Curve> Ret;
-  Ret.x() = if_else(mask, A.x(), B.x());
-  Ret.y() = if_else(mask, A.y(), B.y());
-  Ret.z() = if_else(mask, A.z(), B.z());
-  return Ret;
-}
-
 } // ecsimd
 
 #endif
@@ -0,0 +1,116 @@
+#ifndef ECSIMD_IFMA_H
+#define ECSIMD_IFMA_H
+
+#include <eve/wide.hpp>
+
+#include <ecsimd/mul.h>
+
+#include <immintrin.h>
+
+#include <bit>
+#include <cstdint>
+#include <tuple>
+
+namespace ecsimd {
+
+// 52x52-bit multiply-accumulate primitives, mapped to AVX-512 IFMA
+// (vpmadd52luq/vpmadd52huq) when available. Otherwise, they are emulated
+// with 26-bit partial products, so that code based on them can be tested
+// (or run under Intel SDE) on any target.
+
+namespace details {
+
+template <class Cardinal>
+constexpr bool has_native_ifma() {
+#if defined(__AVX512IFMA__) && !defined(ECSIMD_IFMA_EMULATION)
+  if constexpr (Cardinal::value == 8) {
+    return true;
+  }
+#ifdef __AVX512VL__
+  if constexpr (Cardinal::value == 4 || Cardinal::value == 2) {
+    return true;
+  }
+#endif
+#endif
+  return false;
+}
+
+// Returns the low and high 52 bits of the 104-bit product of the 52 lowest
+// bits of a and b.
+template <class C>
+static auto mul52_emu(eve::wide<uint64_t, C> const a, eve::wide<uint64_t, C> const b) {
+  using W = eve::wide<uint64_t, C>;
+  const W m26{(uint64_t{1} << 26) - 1};
+  const W m52{(uint64_t{1} << 52) - 1};
+
+  const auto a0 = a & m26;
+  const auto a1 = (a >> 26) & m26;
+  const auto b0 = b & m26;
+  const auto b1 = (b >> 26) & m26;
+
+  const auto mid = mullow(a0, b1) + mullow(a1, b0);
+  const auto s = mullow(a0, b0) + ((mid & m26) << 26);
+  const auto lo = s & m52;
+  const auto hi = (s >> 52) + (mid >> 26) + mullow(a1, b1);
+  return std::make_tuple(lo, hi);
+}
+
+} // details
+
+// acc + low52(a[51:0]*b[51:0])
+template <class C>
+static auto madd52lo(eve::wide<uint64_t, C> const acc, eve::wide<uint64_t, C> const a, eve::wide<uint64_t, C> const b) {
+  using W = eve::wide<uint64_t, C>;
+  if constexpr (details::has_native_ifma<C>()) {
+#ifdef __AVX512IFMA__
+    if constexpr (C::value == 8) {
+      return std::bit_cast<W>(_mm512_madd52lo_epu64(
+        std::bit_cast<__m512i>(acc), std::bit_cast<__m512i>(a), std::bit_cast<__m512i>(b)));
+    }
+#ifdef __AVX512VL__
+    else if constexpr (C::value == 4) {
+      return std::bit_cast<W>(_mm256_madd52lo_epu64(
+        std::bit_cast<__m256i>(acc), std::bit_cast<__m256i>(a), std::bit_cast<__m256i>(b)));
+    }
+    else {
+      return std::bit_cast<W>(_mm_madd52lo_epu64(
+        std::bit_cast<__m128i>(acc), std::bit_cast<__m128i>(a), std::bit_cast<__m128i>(b)));
+    }
+#endif
+#endif
+  }
+  else {
+    return acc + std::get<0>(details::mul52_emu(a, b));
+  }
+}
+
+// acc + high52(a[51:0]*b[51:0])
+template <class C>
+static auto madd52hi(eve::wide<uint64_t, C> const acc, eve::wide<uint64_t, C> const a, eve::wide<uint64_t, C> const b) {
+  using W = eve::wide<uint64_t, C>;
+  if constexpr (details::has_native_ifma<C>()) {
+#ifdef __AVX512IFMA__
+    if constexpr (C::value == 8) {
+      return std::bit_cast<W>(_mm512_madd52hi_epu64(
+        std::bit_cast<__m512i>(acc), std::bit_cast<__m512i>(a), std::bit_cast<__m512i>(b)));
+    }
+#ifdef __AVX512VL__
+    else if constexpr (C::value == 4) {
+      return std::bit_cast<W>(_mm256_madd52hi_epu64(
+        std::bit_cast<__m256i>(acc), std::bit_cast<__m256i>(a), std::bit_cast<__m256i>(b)));
+    }
+    else {
+      return std::bit_cast<W>(_mm_madd52hi_epu64(
+        std::bit_cast<__m128i>(acc), std::bit_cast<__m128i>(a), std::bit_cast<__m128i>(b)));
+    }
+#endif
+#endif
+  }
+  else {
+    return acc + std::get<1>(details::mul52_emu(a, b));
+  }
+}
+
+} // ecsimd
+
+#endif
@@ -4,17 +4,26 @@
 #include <ecsimd/curve.h>
 #include <ecsimd/curve_point.h>
 #include <ecsimd/gfp.h>
+#include <ecsimd/ifelse.h>
+
+#include <cassert>
+#include <span>
+#include <vector>
 
 namespace ecsimd {
 
 // TODO: type erasure, only keep the bignum type as a template argument
-template <concepts::curve Curve>
+// MgryRepr is the representation of the coordinates in the Montgomery domain
+// (see GFp).
+template <concepts::curve Curve, class Cardinal = default_cardinal,
+          template <class, class> class MgryRepr = wide_field_bignum>
 struct wide_jacobian_curve_point {
   using curve_type = Curve;
+  using cardinal_type = Cardinal;
   using bignum_type = curve_bn_t<Curve>;
-  using WBN  = curve_wide_bn_t<Curve>;
-  using wide_curve_point_t = wide_curve_point<Curve>;
-  using gfp = GFp<WBN, typename Curve::P>;
+  using WBN  = curve_wide_bn_t<Curve, Cardinal>;
+  using wide_curve_point_t = wide_curve_point<Curve, Cardinal>;
+  using gfp = GFp<WBN, typename Curve::P, MgryRepr<WBN, typename Curve::P>>;
 
   wide_jacobian_curve_point() = default;
   wide_jacobian_curve_point(wide_jacobian_curve_point const&) = default;
@@ -41,6 +50,32 @@ struct wide_jacobian_curve_point {
     return ret;
   }
 
+  // Converts all the points of pts with a single field inversion (see
+  // GFp::batch_inverse). Points at infinity (z == 0) give (0, 0).
+  static void batch_to_affine(std::span<wide_jacobian_curve_point const> pts, std::span<wide_curve_point_t> out) {
+    assert(pts.size() == out.size());
+    const auto invZs = batch_inverse_z(pts);
+    for (size_t i = 0; i < pts.size(); ++i) {
+      const auto invZ2 = invZs[i].sqr();
+      const auto invZ3 = invZ2 * invZs[i];
+      out[i].x() = (pts[i].x_ * invZ2).to_classical();
+      out[i].y() = (pts[i].y_ * invZ3).to_classical();
+    }
+  }
+
+  // Same as batch_to_affine, but keeps the coordinates in the Montgomery
+  // domain: z becomes one, or stays zero for points at infinity.
+  static void batch_normalize(std::span<wide_jacobian_curve_point> pts) {
+    const auto invZs = batch_inverse_z(pts);
+    for (size_t i = 0; i < pts.size(); ++i) {
+      const auto invZ2 = invZs[i].sqr();
+      const auto invZ3 = invZ2 * invZs[i];
+      pts[i].x_ = pts[i].x_ * invZ2;
+      pts[i].y_ = pts[i].y_ * invZ3;
+      pts[i].z_ = pts[i].z_ * invZs[i];
+    }
+  }
+
   auto operator==(wide_jacobian_curve_point const& o) const {
     return x().wbn() == o.x().wbn() && y().wbn() == o.y().wbn() && z().wbn() == o.z().wbn();
   }
@@ -62,11 +97,34 @@ struct wide_jacobian_curve_point {
   auto const& z() const { return z_; }
 
 private:
+  static std::vector<gfp> batch_inverse_z(std::span<wide_jacobian_curve_point const> pts) {
+    std::vector<gfp> ret(pts.size());
+    for (size_t i = 0; i < pts.size(); ++i) {
+      ret[i] = pts[i].z_;
+    }
+    gfp::batch_inverse(ret);
+    return ret;
+  }
+
   gfp x_;
   gfp y_;
   gfp z_;
 };
 
+template <concepts::curve Curve, class Cardinal,
+          template <class, class> class MgryRepr>
+auto if_else(
+    cmp_res_t<curve_wide_bn_t<Curve, Cardinal>> const& mask,
+    wide_jacobian_curve_point<Curve, Cardinal, MgryRepr> const& A,
+    wide_jacobian_curve_point<Curve, Cardinal, MgryRepr> const& B)
+{
+  wide_jacobian_curve_point<Curve, Cardinal, MgryRepr> Ret;
+  Ret.x() = if_else(mask, A.x(), B.x());
+  Ret.y() = if_else(mask, A.y(), B.y());
+  Ret.z() = if_else(mask, A.z(), B.z());
+  return Ret;
+}
+
 } // ecsimd
 
 #endif
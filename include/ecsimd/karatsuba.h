@@ -0,0 +1,151 @@
+#ifndef ECSIMD_KARATSUBA_H
+#define ECSIMD_KARATSUBA_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mul.h>
+#include <ecsimd/wide_digits.h>
+
+#include <algorithm>
+
+namespace ecsimd {
+
+// Operands with fewer digits than this are multiplied with the schoolbook
+// loops of wide_digits.h (see benchs/ops.cpp, mul_*_karatsuba). Karatsuba
+// only splits operands with an even number of digits.
+static constexpr size_t karatsuba_threshold_digits = 32;
+
+namespace details {
+
+template <size_t N, size_t Threshold = karatsuba_threshold_digits>
+static constexpr bool use_karatsuba = N >= Threshold && N % 2 == 0;
+
+template <size_t H, size_t N, class C>
+static auto digits_split(wide_digits<N, C> const& a) {
+  wide_digits<H, C> lo;
+  wide_digits<N-H, C> hi;
+  std::copy(a.begin(), a.begin()+H, lo.begin());
+  std::copy(a.begin()+H, a.end(), hi.begin());
+  return std::make_pair(lo, hi);
+}
+
+// |a-b|, and the mask of the lanes for which a < b
+template <size_t N, class C>
+static auto digits_abs_sub(wide_digits<N, C> const& a, wide_digits<N, C> const& b) {
+  const auto [d, neg] = digits_sub(a, b);
+  const auto [dn, _] = digits_sub(b, a);
+  return std::make_pair(digits_select(neg, dn, d), neg);
+}
+
+// r += v*2**(32*Offset). The carry is propagated up to the last digit of r,
+// whatever its value.
+template <size_t Offset, size_t N, size_t M, class C>
+static void digits_add_at(wide_digits<N, C>& r, wide_digits<M, C> const& v) {
+  static_assert(Offset + M <= N);
+  const auto mask = digits_low_mask<C>();
+  eve::wide<uint64_t, C> carry{0};
+  for (size_t i = 0; i < M; ++i) {
+    const auto s = r[Offset+i] + v[i] + carry;
+    r[Offset+i] = s & mask;
+    carry = s >> digit_bits;
+  }
+  for (size_t i = Offset+M; i < N; ++i) {
+    const auto s = r[i] + carry;
+    r[i] = s & mask;
+    carry = s >> digit_bits;
+  }
+}
+
+// z2*B**2 + (z0 + z2 +/- m)*B + z0, with B = 2**(16*N). m is added in the
+// lanes of add_m, and subtracted in the others.
+template <size_t N, class C, class Mask>
+static auto karatsuba_combine(wide_digits<N, C> const& z0, wide_digits<N, C> const& z2,
+                              wide_digits<N, C> const& m, Mask const& add_m) {
+  constexpr size_t H = N/2;
+  const auto mid = digits_add(z0, z2);
+  wide_digits<N+1, C> mz;
+  std::copy(m.begin(), m.end(), mz.begin());
+  mz[N] = eve::wide<uint64_t, C>{0};
+  const auto mid_add = digits_add(mid, mz);
+  const auto [mid_sub, _] = digits_sub(mid, mz);
+  wide_digits<N+1, C> midc;
+  for (size_t i = 0; i < N+1; ++i) {
+    midc[i] = eve::if_else(add_m, mid_add[i], mid_sub[i]);
+  }
+
+  wide_digits<2*N, C> r;
+  std::copy(z0.begin(), z0.end(), r.begin());
+  std::copy(z2.begin(), z2.end(), r.begin()+N);
+  // The carry out of the last digit is dropped, as a*b fits in 2N digits
+  digits_add_at<H>(r, midc);
+  return r;
+}
+
+} // details
+
+// a*b, with Karatsuba's method (subtractive variant, so that the halves
+// keep the same number of digits) down to Threshold digits
+template <size_t Threshold = karatsuba_threshold_digits, size_t N, class C>
+wide_digits<2*N, C> digits_mul_karatsuba(wide_digits<N, C> const& a, wide_digits<N, C> const& b) {
+  if constexpr (!details::use_karatsuba<N, Threshold>) {
+    return digits_mul(a, b);
+  }
+  else {
+    constexpr size_t H = N/2;
+    const auto [a0, a1] = details::digits_split<H>(a);
+    const auto [b0, b1] = details::digits_split<H>(b);
+    const auto z0 = digits_mul_karatsuba<Threshold>(a0, b0);
+    const auto z2 = digits_mul_karatsuba<Threshold>(a1, b1);
+    // a0*b1 + a1*b0 = z0 + z2 + (a0-a1)*(b1-b0)
+    const auto [da, na] = details::digits_abs_sub(a0, a1);
+    const auto [db, nb] = details::digits_abs_sub(b1, b0);
+    const auto m = digits_mul_karatsuba<Threshold>(da, db);
+    return details::karatsuba_combine(z0, z2, m, na == nb);
+  }
+}
+
+template <size_t Threshold = karatsuba_threshold_digits, size_t N, class C>
+wide_digits<2*N, C> digits_sqr_karatsuba(wide_digits<N, C> const& a) {
+  if constexpr (!details::use_karatsuba<N, Threshold>) {
+    return digits_mul(a, a);
+  }
+  else {
+    constexpr size_t H = N/2;
+    const auto [a0, a1] = details::digits_split<H>(a);
+    const auto z0 = digits_sqr_karatsuba<Threshold>(a0);
+    const auto z2 = digits_sqr_karatsuba<Threshold>(a1);
+    const auto [da, _] = details::digits_abs_sub(a0, a1);
+    const auto m = digits_sqr_karatsuba<Threshold>(da);
+    // 2*a0*a1 = z0 + z2 - (a0-a1)**2
+    return details::karatsuba_combine(z0, z2, m, eve::logical<eve::wide<uint64_t, C>>{false});
+  }
+}
+
+// Up to this number of limbs, mul_karatsuba and sqr_karatsuba use the
+// unrolled kernels of mul.h. Above, the schoolbook loops over wide_digits are
+// faster (and much faster to compile).
+static constexpr size_t unrolled_mul_max_limbs = 4;
+
+// a*b, for wide bignums of any size
+template <concepts::wide_bignum WBN>
+auto mul_karatsuba(WBN const& a, WBN const& b) {
+  if constexpr (bn_nlimbs<WBN> <= unrolled_mul_max_limbs) {
+    return mul(a, b);
+  }
+  else {
+    return from_digits<wbn_zext_t<WBN>>(digits_mul_karatsuba(to_digits(a), to_digits(b)));
+  }
+}
+
+template <concepts::wide_bignum WBN>
+auto sqr_karatsuba(WBN const& a) {
+  if constexpr (bn_nlimbs<WBN> <= unrolled_mul_max_limbs) {
+    return square(a);
+  }
+  else {
+    return from_digits<wbn_zext_t<WBN>>(digits_sqr_karatsuba(to_digits(a)));
+  }
+}
+
+} // ecsimd
+
+#endif
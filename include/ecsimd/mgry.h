@@ -45,8 +45,7 @@ struct wide_mgry_bignum
   }
 
   static wide_mgry_bignum from_classical(WBN const& n) {
-    const auto m = mul(n, WBN{constants_type::Rsq_p});
-    return wide_mgry_bignum{details::mgry_reduce<P_type>(m)};
+    return wide_mgry_bignum{details::mgry_mul<P_type>(n, WBN{constants_type::Rsq_p})};
   }
 
   WBN to_classical() const {
@@ -68,6 +67,16 @@ private:
 namespace concepts {
 template <class T>
 concept wide_mgry_bignum = std::same_as<T, wide_mgry_bignum<typename T::wide_bignum_type, typename T::P_type>>;
+
+// Any representation of elements of GF(P) in the Montgomery domain, that can
+// be used as the storage of GFp (see for instance mgry_r52.h).
+template <class T>
+concept mgry_repr = bignum_cst<typename T::P_type> &&
+  wide_bignum<typename T::wide_bignum_type> &&
+  requires(T const& a) {
+    { T::R() } -> std::same_as<T>;
+    { a.wbn() } -> std::convertible_to<typename T::wide_bignum_type const&>;
+  };
 } // concepts
 
 } // ecsimd
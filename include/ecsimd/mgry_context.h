@@ -0,0 +1,150 @@
+#ifndef ECSIMD_MGRY_CONTEXT_H
+#define ECSIMD_MGRY_CONTEXT_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/ifelse.h>
+#include <ecsimd/mgry_mul.h>
+#include <ecsimd/mgry_ops.h>
+#include <ecsimd/modular.h>
+#include <ecsimd/shift.h>
+
+#include <ctbignum/division.hpp>
+
+#include <eve/function/all.hpp>
+
+#include <cassert>
+
+namespace ecsimd {
+
+namespace details {
+
+// -1/p mod 2**32 for each lane, with p0 the lowest 32 bits of p (as 64-bit
+// lanes). Newton's iteration x = x*(2-p*x) doubles the number of correct
+// bits (p*p = 1 mod 8).
+template <class WL>
+static WL runtime_mprime(WL const& p0)
+{
+  const WL low_mask{0xFFFFFFFF};
+  WL x = p0;
+  for (size_t i = 0; i < 4; ++i) {
+    x = mullow(x, WL{2} - mullow(p0, x)) & low_mask;
+  }
+  return (WL{0} - x) & low_mask;
+}
+
+// R**K % p for each lane, with R = 2**N and N the number of bits of p's
+// bignum type
+template <size_t K, concepts::wide_bignum WBN>
+static WBN runtime_R_pow_mod(WBN const& p)
+{
+  using BN = typename WBN::value_type;
+  constexpr size_t nlimbs = bn_nlimbs<WBN>;
+  return WBN{[&](auto i, auto) {
+    cbn::big_int<K*nlimbs+1, bn_limb_t<WBN>> v{};
+    v[K*nlimbs] = 1;
+    return BN::from(cbn::div(v, p.get(i).cbn()).remainder);
+  }};
+}
+
+} // details
+
+// Montgomery arithmetic modulo a number only known at runtime, that can be
+// different for each lane. The constants (R mod p, R**2 mod p and m') are
+// computed once by the constructor, and the kernels are the ones of the
+// compile-time path (see mgry_mul.h). Numbers in the Montgomery domain are
+// plain WBN.
+template <concepts::wide_bignum WBN>
+class mgry_context {
+public:
+  using wide_bignum_type = WBN;
+  using BN = typename WBN::value_type;
+
+  // Every lane of p must be odd
+  explicit mgry_context(WBN const& p):
+    P_(p),
+    P_zext_(zext_u32x64(p))
+  {
+    assert(eve::all((eve::get<0>(p) & WL{1}) == WL{1}));
+
+    mprime_ = details::runtime_mprime(eve::get<0>(p) & WL{0xFFFFFFFF});
+    R_p_ = details::runtime_R_pow_mod<1>(p);
+    Rsq_p_ = details::runtime_R_pow_mod<2>(p);
+  }
+
+  WBN const& P() const { return P_; }
+
+  // 1 in the Montgomery domain
+  WBN const& R() const { return R_p_; }
+
+  WBN from_classical(WBN const& n) const {
+    return mul(n, Rsq_p_);
+  }
+
+  WBN to_classical(WBN const& n) const {
+    return reduce(pad<bn_nlimbs<WBN>>(n));
+  }
+
+  // n*R**-1 [p], for n < p*R
+  [[gnu::flatten]] WBN reduce(wbn_zext_t<WBN> const& n) const {
+    return details::mgry_reduce(n, P_, P_zext_, mprime_);
+  }
+
+  [[gnu::flatten]] WBN mul(WBN const& a, WBN const& b) const {
+    return finish(details::mgry_mul_u32_zext(zext_u32x64(a), zext_u32x64(b), P_zext_, mprime_));
+  }
+
+  [[gnu::flatten]] WBN sqr(WBN const& a) const {
+    return finish(details::mgry_sqr_u32_zext(zext_u32x64(a), P_zext_, mprime_));
+  }
+
+  // a**(2**N)*R**(1-2**N) [p], unpacked once for the N squarings
+  template <size_t N>
+  [[gnu::flatten]] WBN sqr_n(WBN const& a) const {
+    return trunc_u64x32(details::mgry_sqr_n_u32_zext<N>(zext_u32x64(a), P_zext_, mprime_));
+  }
+
+  WBN add(WBN const& a, WBN const& b) const {
+    return mod_add(a, b, P_);
+  }
+
+  WBN sub(WBN const& a, WBN const& b) const {
+    return mod_sub(a, b, P_);
+  }
+
+  // a**M*R [p] with a sliding window (see mgry_pow_window). M must be
+  // public.
+  template <size_t W = 4, concepts::bignum BE>
+  WBN pow(WBN const& a, BE const& M) const {
+    return details::pow_sliding_window<W>(R_p_, a, M,
+      [this](WBN const& x, WBN const& y) { return mul(x, y); },
+      [this](WBN const& x) { return sqr(x); });
+  }
+
+  // a**M[i]*R [p] in lane i, with a fixed window and masked table lookups
+  template <size_t W = 4, concepts::wide_bignum WE>
+  WBN pow(WBN const& a, WE const& M) const {
+    static_assert(std::is_same_v<eve::cardinal_t<WE>, eve::cardinal_t<WBN>>);
+    return details::pow_fixed_window<W>(R_p_, a, M,
+      [this](WBN const& x, WBN const& y) { return mul(x, y); },
+      [this](WBN const& x) { return sqr(x); },
+      [](auto const& mask, WBN const& x, WBN const& y) { return if_else(mask, x, y); });
+  }
+
+private:
+  using WL = eve::wide<bn_limb_t<WBN>, eve::cardinal_t<WBN>>;
+
+  template <class WT>
+  WBN finish(WT const& t) const {
+    return sub_if_above<bn_nlimbs<WBN>>(trunc_u64x32(t), pad<1>(P_));
+  }
+
+  WBN P_;
+  wbn_zext_t<WBN> P_zext_;
+  WL mprime_;
+  WBN R_p_;
+  WBN Rsq_p_;
+};
+
+} // ecsimd
+
+#endif
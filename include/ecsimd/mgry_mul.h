@@ -14,8 +14,12 @@
 
 #include <eve/wide.hpp>
 #include <eve/detail/meta.hpp>
+#include <eve/function/if_else.hpp>
 #include <eve/traits/cardinal.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <utility>
 #include <limits>
 #include <iostream>
@@ -49,77 +53,407 @@ const eve::wide<bn_limb_t<P_type>, Cardinal> mgry_mul_constants<P_type, Cardinal
 template <concepts::bignum_cst P_type, typename Cardinal>
 const eve::wide<eve::detail::upgrade_t<bn_limb_t<P_type>>, Cardinal> mgry_mul_constants<P_type, Cardinal>::wide_mprime_zext = eve::convert(eve::wide<bn_limb_t<P_type>, Cardinal>{mgry_mul_constants<P_type, Cardinal>::mprime}, eve::as<eve::detail::upgrade_t<bn_limb_t<P_type>>>());
 
-template <concepts::wide_bignum WBN>
-static auto add_no_carry_u32_zext(WBN const& a, WBN const& b)
+// P and m' known at compile time. Given to the Montgomery kernels instead of
+// wide_P_zext and wide_mprime, so that the multiplications by the 32-bit
+// digits of P and by m' are specialized (see mul_p_digit and mul_mprime).
+template <concepts::bignum_cst P_type, typename Cardinal>
+struct mgry_cst_p {
+  using WBN = eve::wide<bn_t<P_type>, Cardinal>;
+  static constexpr size_t ndigits = 2*bn_nlimbs<P_type>;
+
+  static constexpr auto digits = []() {
+    constexpr auto p = P_type::value.cbn();
+    std::array<uint64_t, ndigits> ret{};
+    for (size_t i = 0; i < ndigits; ++i) {
+      ret[i] = (p[i/2] >> (32*(i%2))) & 0xFFFFFFFF;
+    }
+    return ret;
+  }();
+  static constexpr uint64_t mprime = mgry_mul_constants<remap_limb_t<P_type, uint32_t>, Cardinal>::mprime;
+
+  static auto const& wide_P_zext() { return mgry_constants<WBN, P_type>::wide_P_zext; }
+};
+
+template <class T>
+constexpr bool is_mgry_cst_p = false;
+
+template <concepts::bignum_cst P_type, typename Cardinal>
+constexpr bool is_mgry_cst_p<mgry_cst_p<P_type, Cardinal>> = true;
+
+// m*p[J], with m < 2**32. For structured primes (e.g. P-256, whose digits
+// are 0, 1 and 0xFFFFFFFF), most of these are not multiplications anymore.
+template <size_t J, class WL, class PZ>
+static WL mul_p_digit(WL const& m, PZ const& wide_P_zext) {
+  if constexpr (is_mgry_cst_p<PZ>) {
+    constexpr uint64_t d = PZ::digits[J];
+    if constexpr (d == 0) {
+      return eve::zero(eve::as<WL>());
+    }
+    else if constexpr (d == 1) {
+      return m;
+    }
+    else if constexpr (d == 0xFFFFFFFF) {
+      return (m << 32) - m;
+    }
+    else if constexpr (std::has_single_bit(d)) {
+      return m << std::countr_zero(d);
+    }
+    else {
+      return mullow(m, WL{d});
+    }
+  }
+  else {
+    return mullow(m, eve::get<J>(wide_P_zext));
+  }
+}
+
+// u*m' mod 2**32. The runtime version leaves the upper 32 bits of the
+// product, which mullow ignores.
+template <class WL, class MP>
+static WL mul_mprime(WL const& u, MP const& wide_mprime) {
+  const WL low_mask(0xFFFFFFFF);
+  if constexpr (is_mgry_cst_p<MP>) {
+    if constexpr (MP::mprime == 1) {
+      return u & low_mask;
+    }
+    else {
+      return mullow(u, WL{MP::mprime}) & low_mask;
+    }
+  }
+  else {
+    return mullow(u, wide_mprime);
+  }
+}
+
+template <class PZ>
+static auto const& wide_p_zext(PZ const& wide_P_zext) {
+  if constexpr (is_mgry_cst_p<PZ>) {
+    return PZ::wide_P_zext();
+  }
+  else {
+    return wide_P_zext;
+  }
+}
+
+// Montgomery reduction of a (2n limbs) with the modulus wide_P (n limbs),
+// that can be different for each lane. wide_P_zext is wide_P as zero-extended
+// 32-bit digits and wide_mprime -1/p mod 2**32 (see mgry_mul_constants).
+// Both can be given as a mgry_cst_p when P is known at compile time, like in
+// the kernels below.
+template <concepts::wide_bignum WBN, concepts::wide_bignum WP, class WPZ, class MP>
+__attribute__((flatten)) auto mgry_reduce(WBN const& a, WP const& wide_P, WPZ const& wide_P_zext, MP const& wide_mprime)
+{
+  static_assert(bn_nlimbs<WBN> == 2*bn_nlimbs<WP>);
+  static_assert(std::is_same_v<bn_limb_t<WBN>, bn_limb_t<WP>>);
+
+  constexpr auto half_nlimbs = 2*bn_nlimbs<WP>;
+
+  const auto a_zext = zext_u32x64(a);
+  auto accum = pad<1>(a_zext);
+
+  eve::detail::for_<0,1,half_nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    const auto m = mul_mprime(eve::get<i>(accum), wide_mprime);
+    eve::detail::for_<0,1,half_nlimbs>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto j = decltype(j_)::value;
+      eve::get<i+j>(accum) += mul_p_digit<j>(m, wide_P_zext);
+    });
+    propagate_u32_zext<false>(accum);
+  });
+
+  auto result = trunc_u64x32(pad<1>(limb_shift_right<half_nlimbs>(accum)));
+  return sub_if_above<bn_nlimbs<WP>>(result, pad<1>(wide_P));
+}
+
+template <concepts::bignum_cst P_type, concepts::wide_bignum WBN>
+__attribute__((flatten)) auto mgry_reduce(WBN const& a)
 {
-  constexpr auto nlimbs = bn_nlimbs<WBN>;
   using limb_type = bn_limb_t<WBN>;
-  using half_limb_type = eve::detail::downgrade_t<limb_type>;
   using cardinal = eve::cardinal_t<WBN>;
+  using wide_type = wide_bignum<bignum<limb_type, bn_nlimbs<P_type>>, cardinal>;
+  using cst_p = mgry_cst_p<P_type, cardinal>;
+
+  return mgry_reduce(a, mgry_constants<wide_type, P_type>::wide_P, cst_p{}, cst_p{});
+}
+
+// Fused Montgomery multiplication (FIOS): for each digit of b, the partial
+// product a*b[i] and the reduction step are interleaved in a single pass over
+// the 32-bit digits, with one carry chain each. Only n+2 digits are live.
+// a and b are zero-extended 32-bit digits (see zext_u32x64), and the result
+// is returned as n+2 such digits (the last one being always zero), and is
+// lower than 2p.
+template <concepts::wide_bignum WD, class PZ, class MP>
+__attribute__((flatten)) auto mgry_mul_u32_zext(WD const& az, WD const& bz, PZ const& wide_P_zext, MP const& wide_mprime)
+{
+  using limb_type = bn_limb_t<WD>;
+  using half_limb_type = eve::detail::downgrade_t<limb_type>;
+  using cardinal = eve::cardinal_t<WD>;
+  constexpr auto half_nlimbs = bn_nlimbs<WD>;
   constexpr auto half_nbits = std::numeric_limits<half_limb_type>::digits;
 
-  WBN ret;
-  eve::detail::for_<0, 1, nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+  using WL = eve::wide<limb_type, cardinal>;
+  const WL low_mask(std::numeric_limits<half_limb_type>::max());
+
+  auto t = eve::zero(eve::as<eve::wide<bignum<limb_type, half_nlimbs+2>, cardinal>>());
+  eve::detail::for_<0,1,half_nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
     constexpr auto i = decltype(i_)::value;
-    const auto aa = eve::get<i>(a);
-    const auto bb = eve::get<i>(b);
-    const auto sum = aa + bb;
-    eve::get<i>(ret) = sum;
+    const auto bi = eve::get<i>(bz);
+
+    auto u = eve::get<0>(t) + mullow(eve::get<0>(az), bi);
+    auto c0 = u >> half_nbits;
+    // mullow only considers the lowest 32 bits of u and m
+    const auto m = mul_mprime(u, wide_mprime);
+    auto v = (u & low_mask) + mul_p_digit<0>(m, wide_P_zext);
+    auto c1 = v >> half_nbits;
+
+    eve::detail::for_<1,1,half_nlimbs>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto j = decltype(j_)::value;
+      u = eve::get<j>(t) + mullow(eve::get<j>(az), bi) + c0;
+      c0 = u >> half_nbits;
+      v = (u & low_mask) + mul_p_digit<j>(m, wide_P_zext) + c1;
+      c1 = v >> half_nbits;
+      eve::get<j-1>(t) = v & low_mask;
+    });
+
+    u = eve::get<half_nlimbs>(t) + c0 + c1;
+    eve::get<half_nlimbs-1>(t) = u & low_mask;
+    eve::get<half_nlimbs>(t) = u >> half_nbits;
   });
+  return t;
+}
 
-  // Normalize to 32 bits limbs zexted to 64 bits
-  const eve::wide<limb_type, cardinal> low_mask(std::numeric_limits<half_limb_type>::max());
-  eve::detail::for_<1, 1, nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
-    constexpr auto i = decltype(i_)::value;
-    const auto prev = eve::get<i-1>(ret);
-    eve::get<i>(ret) += prev >> half_nbits;
-    eve::get<i-1>(ret) &= low_mask;
+// Fused Montgomery squaring, in product scanning form: each digit of the
+// result accumulates the cross products a[i]*a[j] (i<j, computed once and
+// doubled), a[k/2]**2 and the m[i]*p[j] terms of the reduction. Products are
+// split in two 32-bit halves summed separately, so that carries are only
+// propagated once per digit. Input and output are in the same form as
+// mgry_mul_u32_zext.
+template <concepts::wide_bignum WD, class PZ, class MP>
+__attribute__((flatten)) auto mgry_sqr_u32_zext(WD const& az, PZ const& wide_P_zext, MP const& wide_mprime)
+{
+  using limb_type = bn_limb_t<WD>;
+  using half_limb_type = eve::detail::downgrade_t<limb_type>;
+  using cardinal = eve::cardinal_t<WD>;
+  using WL = eve::wide<limb_type, cardinal>;
+  constexpr auto half_nlimbs = bn_nlimbs<WD>;
+  constexpr auto half_nbits = std::numeric_limits<half_limb_type>::digits;
+
+  const WL low_mask(std::numeric_limits<half_limb_type>::max());
+
+  WD m;
+  auto t = eve::zero(eve::as<eve::wide<bignum<limb_type, half_nlimbs+2>, cardinal>>());
+  WL acc_lo = eve::zero(eve::as<WL>());
+  WL acc_hi = eve::zero(eve::as<WL>());
+  auto acc_add = [&](WL const& x) EVE_LAMBDA_FORCEINLINE {
+    acc_lo += x & low_mask;
+    acc_hi += x >> half_nbits;
+  };
+
+  eve::detail::for_<0,1,2*half_nlimbs>([&](auto k_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto k = decltype(k_)::value;
+    constexpr auto imin = k < half_nlimbs ? 0 : k-half_nlimbs+1;
+
+    WL cross_lo = eve::zero(eve::as<WL>());
+    WL cross_hi = eve::zero(eve::as<WL>());
+    eve::detail::for_<imin,1,(k+1)/2>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto i = decltype(i_)::value;
+      const auto x = mullow(eve::get<i>(az), eve::get<k-i>(az));
+      cross_lo += x & low_mask;
+      cross_hi += x >> half_nbits;
+    });
+    acc_lo += cross_lo << 1;
+    acc_hi += cross_hi << 1;
+    if constexpr (k % 2 == 0 && k/2 < half_nlimbs) {
+      acc_add(mullow(eve::get<k/2>(az), eve::get<k/2>(az)));
+    }
+
+    eve::detail::for_<imin,1,std::min<size_t>(k, half_nlimbs)>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto i = decltype(i_)::value;
+      acc_add(mul_p_digit<k-i>(eve::get<i>(m), wide_P_zext));
+    });
+
+    if constexpr (k < half_nlimbs) {
+      // mullow only considers the lowest 32 bits of acc_lo, so that the
+      // lowest digit of the accumulator becomes zero.
+      eve::get<k>(m) = mul_mprime(acc_lo, wide_mprime);
+      acc_add(mul_p_digit<0>(eve::get<k>(m), wide_P_zext));
+    }
+    else {
+      eve::get<k-half_nlimbs>(t) = acc_lo & low_mask;
+    }
+    acc_lo = (acc_lo >> half_nbits) + acc_hi;
+    acc_hi = eve::zero(eve::as<WL>());
   });
-  // TODO: is this necessary?
-  eve::get<nlimbs-1>(ret) &= low_mask;
+  eve::get<half_nlimbs>(t) = acc_lo;
+  return t;
+}
+
+// Montgomery reduction of t+top*2**(2N), with t 2n zero-extended 32-bit
+// digits lower than 2**32, in the product scanning form of
+// mgry_sqr_u32_zext. Returns (t+top*2**(2N)+m*p)/2**N as n+1 digits, the
+// last one holding the carry.
+template <concepts::wide_bignum WT, class WL, class PZ, class MP>
+__attribute__((flatten)) auto mgry_reduce_u32_zext(WT const& t, WL const& top, PZ const& wide_P_zext, MP const& wide_mprime)
+{
+  using limb_type = bn_limb_t<WT>;
+  using half_limb_type = eve::detail::downgrade_t<limb_type>;
+  using cardinal = eve::cardinal_t<WT>;
+  constexpr auto half_nlimbs = bn_nlimbs<WT>/2;
+  constexpr auto half_nbits = std::numeric_limits<half_limb_type>::digits;
+  static_assert(bn_nlimbs<WT> == 2*half_nlimbs);
 
+  const WL low_mask(std::numeric_limits<half_limb_type>::max());
+
+  eve::wide<bignum<limb_type, half_nlimbs>, cardinal> m;
+  eve::wide<bignum<limb_type, half_nlimbs+1>, cardinal> ret;
+  WL acc_lo = eve::zero(eve::as<WL>());
+  WL acc_hi = eve::zero(eve::as<WL>());
+  auto acc_add = [&](WL const& x) EVE_LAMBDA_FORCEINLINE {
+    acc_lo += x & low_mask;
+    acc_hi += x >> half_nbits;
+  };
+
+  eve::detail::for_<0,1,2*half_nlimbs>([&](auto k_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto k = decltype(k_)::value;
+    constexpr auto imin = k < half_nlimbs ? 0 : k-half_nlimbs+1;
+
+    acc_lo += eve::get<k>(t);
+    eve::detail::for_<imin,1,std::min<size_t>(k, half_nlimbs)>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto i = decltype(i_)::value;
+      acc_add(mul_p_digit<k-i>(eve::get<i>(m), wide_P_zext));
+    });
+
+    if constexpr (k < half_nlimbs) {
+      eve::get<k>(m) = mul_mprime(acc_lo, wide_mprime);
+      acc_add(mul_p_digit<0>(eve::get<k>(m), wide_P_zext));
+    }
+    else {
+      eve::get<k-half_nlimbs>(ret) = acc_lo & low_mask;
+    }
+    acc_lo = (acc_lo >> half_nbits) + acc_hi;
+    acc_hi = eve::zero(eve::as<WL>());
+  });
+  eve::get<half_nlimbs>(ret) = acc_lo + top;
   return ret;
 }
 
-template <concepts::bignum_cst P_type, concepts::wide_bignum WBN>
-__attribute__((flatten)) auto mgry_reduce(WBN const& a)
+// a-p if a+top*2**N >= p, else a. a+top*2**N must be lower than 2p.
+template <concepts::wide_bignum WD>
+static auto u32x64_sub_if_above(WD const& a, WD const& p, eve::wide<bn_limb_t<WD>, eve::cardinal_t<WD>> const& top)
 {
-  static_assert(bn_nlimbs<WBN> == 2*bn_nlimbs<P_type>);
-  static_assert(std::is_same_v<bn_limb_t<WBN>, bn_limb_t<P_type>>);
+  constexpr auto ndigits = bn_nlimbs<WD>;
+  WD diff;
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    eve::get<i>(diff) = eve::get<i>(a) - eve::get<i>(p);
+  });
+  // The borrow is either 0 or -1
+  const auto borrow = propagate_u32_zext<true>(diff);
+  const auto below = wide_is_msb_set(top + borrow);
 
-  using limb_type = bn_limb_t<WBN>;
-  using half_limb_type = eve::detail::downgrade_t<limb_type>;
-  using cardinal = eve::cardinal_t<WBN>;
-  using half_P_type = remap_limb_t<P_type, half_limb_type>;
-  using mul_csts = mgry_mul_constants<half_P_type, cardinal>;
-  constexpr auto nlimbs = bn_nlimbs<P_type>;
-  constexpr auto half_nlimbs = bn_nlimbs<half_P_type>;
+  WD ret;
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    eve::get<i>(ret) = eve::if_else(below, eve::get<i>(a), eve::get<i>(diff));
+  });
+  return ret;
+}
 
-  using wide_half_type = wide_bignum<bignum<half_limb_type, half_nlimbs>>;
-  using wide_type = wide_bignum<bignum<limb_type, nlimbs>>;
+// N consecutive Montgomery squarings of az (see mgry_sqr_u32_zext), that
+// must be lower than p. Intermediate results are brought back below p
+// without leaving the zero-extended digit form.
+template <size_t N, concepts::wide_bignum WD, class PZ, class MP>
+__attribute__((flatten)) WD mgry_sqr_n_u32_zext(WD az, PZ const& wide_P_zext, MP const& wide_mprime)
+{
+  static_assert(N > 0);
+  constexpr auto ndigits = bn_nlimbs<WD>;
+  for (size_t n = 0; n < N; ++n) {
+    const auto t = mgry_sqr_u32_zext(az, wide_P_zext, wide_mprime);
+    eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto i = decltype(i_)::value;
+      eve::get<i>(az) = eve::get<i>(t);
+    });
+    az = u32x64_sub_if_above(az, wide_p_zext(wide_P_zext), eve::get<ndigits>(t));
+  }
+  return az;
+}
 
-  const auto a_zext = zext_u32x64(a);
-  auto accum = pad<1>(a_zext);
-  constexpr auto nlimbs_accum = bn_nlimbs<decltype(accum)>;
+template <concepts::bignum_cst P_type, concepts::wide_bignum WD>
+__attribute__((flatten)) auto mgry_mul_u32_zext(WD const& az, WD const& bz)
+{
+  using cardinal = eve::cardinal_t<WD>;
+  using half_P_type = remap_limb_t<P_type, eve::detail::downgrade_t<bn_limb_t<WD>>>;
+  using cst_p = mgry_cst_p<P_type, cardinal>;
+  static_assert(bn_nlimbs<WD> == bn_nlimbs<half_P_type>);
+  return mgry_mul_u32_zext(az, bz, cst_p{}, cst_p{});
+}
+
+template <concepts::bignum_cst P_type, concepts::wide_bignum WD>
+__attribute__((flatten)) auto mgry_sqr_u32_zext(WD const& az)
+{
+  using cardinal = eve::cardinal_t<WD>;
+  using half_P_type = remap_limb_t<P_type, eve::detail::downgrade_t<bn_limb_t<WD>>>;
+  using cst_p = mgry_cst_p<P_type, cardinal>;
+  static_assert(bn_nlimbs<WD> == bn_nlimbs<half_P_type>);
+  return mgry_sqr_u32_zext(az, cst_p{}, cst_p{});
+}
 
-  // TODO: make sure these converts happens at compile time
-  const auto& wide_P_zext = mgry_constants<wide_type, P_type>::wide_P_zext;
-  const auto& wide_mprime = mul_csts::wide_mprime_zext;
-  const eve::wide<limb_type, cardinal> low_mask(std::numeric_limits<half_limb_type>::max());
+// Reduces the output of mgry_{mul,sqr}_u32_zext
+template <concepts::bignum_cst P, concepts::wide_bignum WT>
+static auto u32x64_mgry_finish(WT const& t)
+{
+  using cardinal = eve::cardinal_t<WT>;
+  using WBN = eve::wide<bn_t<P>, cardinal>;
+  using WD = wbn_zext_t<WBN>;
+  constexpr auto ndigits = bn_nlimbs<WD>;
 
-  eve::detail::for_<0,1,half_nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+  WD ret;
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
     constexpr auto i = decltype(i_)::value;
-    // '& low_mask' could be set to mullow, but limb_mul_zext already only considers the lowest 32bits
-    auto prod = limb_mul_zext(wide_P_zext, mullow(eve::get<i>(accum), wide_mprime));
-    auto prod2 = limb_shift_left<nlimbs_accum, i>(prod);
-    accum = add_no_carry_u32_zext(accum, prod2);
+    eve::get<i>(ret) = eve::get<i>(t);
   });
+  return u32x64_sub_if_above(ret, mgry_constants<WBN, P>::wide_P_zext, eve::get<ndigits>(t));
+}
 
-  auto result = trunc_u64x32(pad<1>(limb_shift_right<half_nlimbs>(accum)));
-  const auto wide_P_pad1 = pad<1>(mgry_constants<wide_type, P_type>::wide_P);
+template <concepts::bignum_cst P_type, size_t N, concepts::wide_bignum WD>
+__attribute__((flatten)) auto mgry_sqr_n_u32_zext(WD const& az)
+{
+  using cardinal = eve::cardinal_t<WD>;
+  using half_P_type = remap_limb_t<P_type, eve::detail::downgrade_t<bn_limb_t<WD>>>;
+  using cst_p = mgry_cst_p<P_type, cardinal>;
+  static_assert(bn_nlimbs<WD> == bn_nlimbs<half_P_type>);
+  return mgry_sqr_n_u32_zext<N>(az, cst_p{}, cst_p{});
+}
+
+// Fused Montgomery multiplication of packed numbers (see mgry_mul_u32_zext).
+// Operands are unpacked and the result packed only once.
+template <concepts::bignum_cst P_type, concepts::wide_bignum WBN>
+__attribute__((flatten)) WBN mgry_mul(WBN const& a, WBN const& b)
+{
+  static_assert(bn_nlimbs<WBN> == bn_nlimbs<P_type>);
+  const auto result = trunc_u64x32(mgry_mul_u32_zext<P_type>(zext_u32x64(a), zext_u32x64(b)));
+  const auto wide_P_pad1 = pad<1>(mgry_constants<WBN, P_type>::wide_P);
+  return sub_if_above<bn_nlimbs<P_type>>(result, wide_P_pad1);
+}
+
+template <concepts::bignum_cst P_type, concepts::wide_bignum WBN>
+__attribute__((flatten)) WBN mgry_sqr(WBN const& a)
+{
+  static_assert(bn_nlimbs<WBN> == bn_nlimbs<P_type>);
+  const auto result = trunc_u64x32(mgry_sqr_u32_zext<P_type>(zext_u32x64(a)));
+  const auto wide_P_pad1 = pad<1>(mgry_constants<WBN, P_type>::wide_P);
   return sub_if_above<bn_nlimbs<P_type>>(result, wide_P_pad1);
 }
 
+// a**(2**N)*R**(1-2**N) [p]: a is unpacked and the result packed only once
+// for the N squarings.
+template <concepts::bignum_cst P_type, size_t N, concepts::wide_bignum WBN>
+__attribute__((flatten)) WBN mgry_sqr_n(WBN const& a)
+{
+  static_assert(bn_nlimbs<WBN> == bn_nlimbs<P_type>);
+  return trunc_u64x32(mgry_sqr_n_u32_zext<P_type, N>(zext_u32x64(a)));
+}
+
 } // ecsimd::details
 
 #endif
@@ -1,10 +1,16 @@
 #ifndef ECSIMD_MGRY_OPS_H
 #define ECSIMD_MGRY_OPS_H
 
+#include <ecsimd/ifelse.h>
 #include <ecsimd/mgry.h>
 #include <ecsimd/mgry_mul.h>
 #include <ecsimd/modular.h>
 
+#include <eve/function/if_else.hpp>
+
+#include <array>
+#include <limits>
+
 namespace ecsimd {
 
 template <concepts::wide_mgry_bignum WMBN>
@@ -28,28 +34,51 @@ WMBN mgry_sub(WMBN const& a, WMBN const& b) {
   return WMBN{mod_sub(a.wbn(), b.wbn(), WMBN::constants_type::wide_P)};
 }
 
+// Computes (p-1)*R - (a-R) = -a [p], so that the result stays in [0,p[
+template <concepts::wide_mgry_bignum WMBN>
+WMBN mgry_neg(WMBN const& a) {
+  using constants_type = typename WMBN::constants_type;
+  using WBN = typename WMBN::wide_bignum_type;
+  const WMBN am = mgry_sub(a, WMBN::R());
+  return mgry_sub(WMBN{WBN{constants_type::Pm1_by_R_p}}, am);
+}
+
 template <concepts::wide_mgry_bignum WMBN>
 [[gnu::flatten]] WMBN mgry_mul(WMBN const& a, WMBN const& b) {
-  auto m = mul(a.wbn(), b.wbn());
-  return WMBN{details::mgry_reduce<typename WMBN::P_type>(m)};
+  return WMBN{details::mgry_mul<typename WMBN::P_type>(a.wbn(), b.wbn())};
 }
 
 template <concepts::wide_mgry_bignum WMBN>
 [[gnu::flatten]] WMBN mgry_sqr(WMBN const& v) {
-  auto s = square(v.wbn());
-  return WMBN{details::mgry_reduce<typename WMBN::P_type>(s)};
-  //return mgry_mul(v,v);
+  return WMBN{details::mgry_sqr<typename WMBN::P_type>(v.wbn())};
 }
 
-// computes a**M*R [p]. Not safe from side channels leak of the exponent M.
-template <concepts::wide_mgry_bignum WMBN>
-WMBN mgry_pow(WMBN const& a, typename WMBN::bignum_type const& M) {
-  using constants_t = typename WMBN::constants_type;
-  using WBN = typename WMBN::wide_bignum_type;
-  using limb_type = bn_limb_t<WBN>;
+// v**(2**N) in the Montgomery domain. wide_mgry_bignum numbers stay unpacked
+// for the N squarings (see details::mgry_sqr_n), other representations
+// chain their own mgry_sqr.
+template <size_t N, concepts::mgry_repr WMBN>
+WMBN mgry_sqr_n(WMBN const& v) {
+  static_assert(N > 0);
+  if constexpr (concepts::wide_mgry_bignum<WMBN>) {
+    return WMBN{details::mgry_sqr_n<typename WMBN::P_type, N>(v.wbn())};
+  }
+  else {
+    auto ret = mgry_sqr(v);
+    for (size_t i = 1; i < N; ++i) {
+      ret = mgry_sqr(ret);
+    }
+    return ret;
+  }
+}
+
+// computes a**M*R [p]. Not safe from side channels leak of the exponent M
+// (see mgry_pow_ladder).
+template <concepts::mgry_repr WMBN, concepts::bignum BN>
+WMBN mgry_pow(WMBN const& a, BN const& M) {
+  using limb_type = bn_limb_t<BN>;
   constexpr size_t nbits = std::numeric_limits<limb_type>::digits;
 
-  auto result = WMBN{WBN{constants_t::R_p}};
+  auto result = WMBN::R();
   const auto m = M.cbn();
 
   auto it_bzero = std::find_if(std::rbegin(m), std::rend(m), [](auto v) { return v != 0; }).base();
@@ -85,6 +114,192 @@ WMBN mgry_pow(WMBN const& a, typename WMBN::bignum_type const& M) {
   return result;
 }
 
+namespace details {
+
+// Bits [bit, bit+W) of M (bit + W can be past the end)
+template <size_t W, concepts::bignum BN>
+static auto bn_window(BN const& M, size_t bit) {
+  using limb_type = bn_limb_t<BN>;
+  constexpr size_t limb_bits = std::numeric_limits<limb_type>::digits;
+  const auto m = M.cbn();
+  const size_t l = bit / limb_bits;
+  const size_t off = bit % limb_bits;
+  limb_type ret = m[l] >> off;
+  if (off + W > limb_bits && l+1 < m.size()) {
+    ret |= m[l+1] << (limb_bits - off);
+  }
+  return ret & ((limb_type{1} << W) - 1);
+}
+
+// Same as bn_window, for each lane of M
+template <size_t W, concepts::wide_bignum WBN>
+static auto wbn_window(WBN const& M, size_t bit) {
+  using limb_type = bn_limb_t<WBN>;
+  using WL = eve::wide<limb_type, eve::cardinal_t<WBN>>;
+  constexpr size_t limb_bits = std::numeric_limits<limb_type>::digits;
+  constexpr size_t nlimbs = bn_nlimbs<WBN>;
+  const size_t l = bit / limb_bits;
+  const size_t off = bit % limb_bits;
+  WL ret = eve::zero(eve::as<WL>());
+  eve::detail::for_<0,1,nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    if (i == l) {
+      ret |= eve::get<i>(M) >> off;
+    }
+    else if (i == l+1 && off + W > limb_bits) {
+      ret |= eve::get<i>(M) << (limb_bits - off);
+    }
+  });
+  return ret & WL{(limb_type{1} << W) - 1};
+}
+
+// Implementations of mgry_pow_window, shared with mgry_context. one is 1 in
+// the Montgomery domain, and mul, sqr and select the operations on T.
+template <size_t W, class T, concepts::bignum BN, class Mul, class Sqr>
+T pow_sliding_window(T const& one, T const& a, BN const& M, Mul const& mul, Sqr const& sqr) {
+  static_assert(W >= 1 && W < 8);
+  using limb_type = bn_limb_t<BN>;
+  constexpr size_t limb_bits = std::numeric_limits<limb_type>::digits;
+  constexpr size_t nbits = bn_nlimbs<BN> * limb_bits;
+
+  const auto m = M.cbn();
+  auto test_bit = [&](size_t b) {
+    return (m[b / limb_bits] >> (b % limb_bits)) & 1;
+  };
+
+  std::array<T, size_t{1} << (W-1)> odd_pows;
+  odd_pows[0] = a;
+  if constexpr (W > 1) {
+    const auto a2 = sqr(a);
+    for (size_t i = 1; i < odd_pows.size(); ++i) {
+      odd_pows[i] = mul(odd_pows[i-1], a2);
+    }
+  }
+
+  auto result = one;
+  bool first = true;
+  size_t i = nbits;
+  while (i > 0) {
+    if (!test_bit(i-1)) {
+      if (!first) {
+        result = sqr(result);
+      }
+      --i;
+      continue;
+    }
+    // Longest window [j, i) of at most W bits that ends with a one
+    size_t j = i >= W ? i-W : 0;
+    while (!test_bit(j)) {
+      ++j;
+    }
+    const auto win = bn_window<W>(M, j) & ((limb_type{1} << (i-j)) - 1);
+    if (first) {
+      result = odd_pows[win >> 1];
+      first = false;
+    }
+    else {
+      for (size_t k = j; k < i; ++k) {
+        result = sqr(result);
+      }
+      result = mul(result, odd_pows[win >> 1]);
+    }
+    i = j;
+  }
+  return result;
+}
+
+template <size_t W, class T, concepts::wide_bignum WE, class Mul, class Sqr, class Select>
+T pow_fixed_window(T const& one, T const& a, WE const& M, Mul const& mul, Sqr const& sqr, Select const& select) {
+  static_assert(W >= 1 && W < 8);
+  using limb_type = bn_limb_t<WE>;
+  using WL = eve::wide<limb_type, eve::cardinal_t<WE>>;
+  constexpr size_t nbits = bn_nlimbs<WE> * std::numeric_limits<limb_type>::digits;
+  constexpr size_t nwindows = (nbits + W - 1) / W;
+  constexpr size_t table_size = size_t{1} << W;
+
+  std::array<T, table_size> pows;
+  pows[0] = one;
+  pows[1] = a;
+  for (size_t i = 2; i < table_size; ++i) {
+    pows[i] = (i & 1) ? mul(pows[i-1], a) : sqr(pows[i/2]);
+  }
+
+  auto lookup = [&](WL const& win) {
+    auto ret = pows[0];
+    for (size_t i = 1; i < table_size; ++i) {
+      ret = select(win == WL{limb_type(i)}, pows[i], ret);
+    }
+    return ret;
+  };
+
+  auto result = lookup(wbn_window<W>(M, (nwindows-1)*W));
+  for (size_t w = nwindows-1; w > 0; --w) {
+    for (size_t k = 0; k < W; ++k) {
+      result = sqr(result);
+    }
+    result = mul(result, lookup(wbn_window<W>(M, (w-1)*W)));
+  }
+  return result;
+}
+
+} // details
+
+// Sliding window exponentiation: computes a**M*R [p], with the odd powers
+// a**1, a**3, ..., a**(2**W-1) precomputed. Like mgry_pow, the sequence of
+// operations depends on M, which must be public.
+template <size_t W = 4, concepts::mgry_repr WMBN, concepts::bignum BN>
+WMBN mgry_pow_window(WMBN const& a, BN const& M) {
+  return details::pow_sliding_window<W>(WMBN::R(), a, M,
+    [](WMBN const& x, WMBN const& y) { return mgry_mul(x, y); },
+    [](WMBN const& x) { return mgry_sqr(x); });
+}
+
+// Fixed window exponentiation with a different exponent for each lane of M:
+// computes a**M[i]*R [p] in lane i. The table of the 2**W first powers of a
+// is read with masked selects, so that the sequence of operations and of
+// memory accesses does not depend on M.
+template <size_t W = 4, concepts::mgry_repr WMBN, concepts::wide_bignum WE>
+WMBN mgry_pow_window(WMBN const& a, WE const& M) {
+  static_assert(std::is_same_v<eve::cardinal_t<WE>, eve::cardinal_t<typename WMBN::wide_bignum_type>>);
+  return details::pow_fixed_window<W>(WMBN::R(), a, M,
+    [](WMBN const& x, WMBN const& y) { return mgry_mul(x, y); },
+    [](WMBN const& x) { return mgry_sqr(x); },
+    [](auto const& mask, WMBN const& x, WMBN const& y) { return if_else(mask, x, y); });
+}
+
+// Montgomery ladder: computes a**M*R [p] with one multiplication and one
+// squaring for each bit of BN, whatever the value of M. The swaps of the two
+// accumulators are masked selects, so that M can be secret.
+template <concepts::mgry_repr WMBN, concepts::bignum BN>
+WMBN mgry_pow_ladder(WMBN const& a, BN const& M) {
+  using limb_type = bn_limb_t<BN>;
+  using WL = eve::wide<limb_type, eve::cardinal_t<typename WMBN::wide_bignum_type>>;
+  constexpr size_t limb_bits = std::numeric_limits<limb_type>::digits;
+
+  auto cswap = [](WL const& mask, WMBN& r0, WMBN& r1) {
+    const auto swap = mask != eve::zero(eve::as<WL>());
+    const auto t = if_else(swap, r1, r0);
+    r1 = if_else(swap, r0, r1);
+    r0 = t;
+  };
+
+  const auto m = M.cbn();
+  auto r0 = WMBN::R();
+  auto r1 = a;
+  limb_type prev = 0;
+  for (size_t l = m.size(); l-- > 0;) {
+    for (size_t b = limb_bits; b-- > 0;) {
+      const limb_type bit = (m[l] >> b) & 1;
+      cswap(WL{bit ^ prev}, r0, r1);
+      prev = bit;
+      r1 = mgry_mul(r0, r1);
+      r0 = mgry_sqr(r0);
+    }
+  }
+  cswap(WL{prev}, r0, r1);
+  return r0;
+}
+
 template <concepts::wide_mgry_bignum WMBN>
 WMBN operator+(WMBN const& a, WMBN const& b) {
   return mgry_add(a,b);
@@ -0,0 +1,95 @@
+#ifndef ECSIMD_MGRY_R29_H
+#define ECSIMD_MGRY_R29_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mgry_unsat.h>
+#include <ecsimd/mul.h>
+
+#include <eve/wide.hpp>
+
+#include <cstdint>
+
+namespace ecsimd {
+
+// Montgomery arithmetic over unsaturated radix 2**29 digits, with R =
+// 2**(29*ndigits). Each digit is stored in a 64-bit lane, and products of
+// normalized digits (computed with mullow) are 58 bits wide, so that they
+// can be accumulated without propagating carries. A 256-bit field element is
+// stored as 9 digits.
+//
+// Lazy additions and shifts (see gfp_lazy.h) never propagate carries: digits
+// simply grow, and are only normalized by subtractions, by the Montgomery
+// multiplication and by reductions.
+
+namespace details {
+
+template <>
+struct unsat_radix<29>
+{
+  static constexpr bool deferred_carries = true;
+
+  // Almost Montgomery multiplication: returns a*b/R % p, in [0, 2p)
+  // (unnormalized). a and b must be normalized, and a*b < R*p.
+  template <concepts::bignum_cst P, concepts::wide_bignum WD>
+  static auto amm(WD const& a, WD const& b)
+  {
+    using cardinal = eve::cardinal_t<WD>;
+    using WL = eve::wide<uint64_t, cardinal>;
+    using csts = mgry_unsat_constants<P, cardinal, 29>;
+    constexpr auto ndigits = bn_nlimbs<WD>;
+    static_assert(ndigits == csts::ndigits);
+    // Every digit of the accumulator sums at most 2*ndigits products and a
+    // carry
+    static_assert(2*ndigits+1 < (size_t{1} << (64-58)));
+
+    const WL mprime{csts::mprime};
+    const WL mask{unsat_mask<29>};
+    const WL zero = eve::zero(eve::as<WL>());
+
+    WL acc[ndigits];
+    for (auto& v: acc) {
+      v = zero;
+    }
+
+    eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto i = decltype(i_)::value;
+      const auto bi = eve::get<i>(b);
+      eve::detail::for_<0,1,ndigits>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+        constexpr auto j = decltype(j_)::value;
+        acc[j] += mullow(eve::get<j>(a), bi);
+      });
+
+      // mullow only considers the lowest 32 bits of acc[0]
+      const auto u = mullow(acc[0], mprime) & mask;
+      eve::detail::for_<0,1,ndigits>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+        constexpr auto j = decltype(j_)::value;
+        acc[j] += mullow(u, WL{kumi::get<j>(csts::P_digits)});
+      });
+
+      // The lowest 29 bits of acc[0] are now zero.
+      const auto carry = acc[0] >> 29;
+      eve::detail::for_<0,1,ndigits-1>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+        constexpr auto j = decltype(j_)::value;
+        acc[j] = acc[j+1];
+      });
+      acc[ndigits-1] = zero;
+      acc[0] += carry;
+    });
+
+    WD ret;
+    eve::detail::for_<0,1,ndigits>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto j = decltype(j_)::value;
+      eve::get<j>(ret) = acc[j];
+    });
+    return ret;
+  }
+};
+
+} // details
+
+template <concepts::wide_bignum WBN, concepts::bignum_cst P>
+using wide_mgry_r29 = wide_mgry_unsat<WBN, P, 29>;
+
+} // ecsimd
+
+#endif
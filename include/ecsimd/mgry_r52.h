@@ -0,0 +1,89 @@
+#ifndef ECSIMD_MGRY_R52_H
+#define ECSIMD_MGRY_R52_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mgry_unsat.h>
+#include <ecsimd/ifma.h>
+
+#include <eve/wide.hpp>
+
+#include <cstdint>
+
+namespace ecsimd {
+
+// Montgomery arithmetic over radix 2**52 digits, with R = 2**(52*ndigits).
+// Each digit is stored in a 64-bit lane, which allows multiplications to be
+// done with the AVX-512 IFMA instructions (see ifma.h). A 256-bit field
+// element is thus stored as 5 digits. Lazy additions and shifts normalize
+// their results.
+
+namespace details {
+
+template <>
+struct unsat_radix<52>
+{
+  static constexpr bool deferred_carries = false;
+
+  // Almost Montgomery multiplication: returns a*b/R % p, in [0, 2p)
+  // (unnormalized). a and b must be normalized, and a*b < R*p.
+  template <concepts::bignum_cst P, concepts::wide_bignum WD>
+  static auto amm(WD const& a, WD const& b)
+  {
+    using cardinal = eve::cardinal_t<WD>;
+    using WL = eve::wide<uint64_t, cardinal>;
+    using csts = mgry_unsat_constants<P, cardinal, 52>;
+    constexpr auto ndigits = bn_nlimbs<WD>;
+    static_assert(ndigits == csts::ndigits);
+
+    const WL mprime{csts::mprime};
+    const WL zero = eve::zero(eve::as<WL>());
+
+    WL acc[ndigits+1];
+    for (auto& v: acc) {
+      v = zero;
+    }
+
+    eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto i = decltype(i_)::value;
+      const auto bi = eve::get<i>(b);
+      eve::detail::for_<0,1,ndigits>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+        constexpr auto j = decltype(j_)::value;
+        acc[j]   = madd52lo(acc[j],   eve::get<j>(a), bi);
+        acc[j+1] = madd52hi(acc[j+1], eve::get<j>(a), bi);
+      });
+
+      const auto u = madd52lo(zero, acc[0], mprime);
+      eve::detail::for_<0,1,ndigits>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+        constexpr auto j = decltype(j_)::value;
+        const WL pj{kumi::get<j>(csts::P_digits)};
+        acc[j]   = madd52lo(acc[j],   pj, u);
+        acc[j+1] = madd52hi(acc[j+1], pj, u);
+      });
+
+      // The lowest 52 bits of acc[0] are now zero.
+      const auto carry = acc[0] >> 52;
+      eve::detail::for_<0,1,ndigits>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+        constexpr auto j = decltype(j_)::value;
+        acc[j] = acc[j+1];
+      });
+      acc[ndigits] = zero;
+      acc[0] += carry;
+    });
+
+    WD ret;
+    eve::detail::for_<0,1,ndigits>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto j = decltype(j_)::value;
+      eve::get<j>(ret) = acc[j];
+    });
+    return ret;
+  }
+};
+
+} // details
+
+template <concepts::wide_bignum WBN, concepts::bignum_cst P>
+using wide_mgry_r52 = wide_mgry_unsat<WBN, P, 52>;
+
+} // ecsimd
+
+#endif
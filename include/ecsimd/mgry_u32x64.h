@@ -0,0 +1,167 @@
+#ifndef ECSIMD_MGRY_U32X64_H
+#define ECSIMD_MGRY_U32X64_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mgry.h>
+#include <ecsimd/mgry_csts.h>
+#include <ecsimd/mgry_mul.h>
+#include <ecsimd/mul.h>
+#include <ecsimd/utility.h>
+
+#include <eve/wide.hpp>
+#include <eve/function/if_else.hpp>
+
+#include <cstdint>
+
+namespace ecsimd {
+
+// Montgomery arithmetic over 32-bit digits, each zero-extended in a 64-bit
+// lane (see zext_u32x64). Field elements stay in this form from
+// from_classical to to_classical, so that the (un)packing done by every
+// wide_mgry_bignum multiplication only happens at the API boundary.
+
+template <concepts::wide_bignum WBN, concepts::bignum_cst P>
+struct wide_mgry_u32x64
+{
+  using classical_type = WBN;
+  using P_type = P;
+  using constants_type = mgry_constants<WBN, P>;
+  using wide_bignum_type = wbn_zext_t<WBN>;
+  using bignum_type = typename wide_bignum_type::value_type;
+
+  wide_mgry_u32x64() = default;
+
+  wide_mgry_u32x64(wide_bignum_type const& n):
+    n_(n)
+  { }
+
+  static wide_mgry_u32x64 R() {
+    return wide_mgry_u32x64{wide_R_p};
+  }
+
+  static wide_mgry_u32x64 from_classical(WBN const& n) {
+    return wide_mgry_u32x64{details::u32x64_mgry_finish<P>(
+      details::mgry_mul_u32_zext<P>(zext_u32x64(n), wide_Rsq_p))};
+  }
+
+  WBN to_classical() const {
+    const auto one = wide_bignum_type{bignum_type::from(1)};
+    return trunc_u64x32(details::u32x64_mgry_finish<P>(details::mgry_mul_u32_zext<P>(n_, one)));
+  }
+
+  wide_bignum_type const& wbn() const { return n_; }
+  wide_bignum_type& wbn() { return n_; }
+
+  static const wide_bignum_type wide_R_p;
+  static const wide_bignum_type wide_Rsq_p;
+
+private:
+  wide_bignum_type n_;
+};
+
+template <concepts::wide_bignum WBN, concepts::bignum_cst P>
+const typename wide_mgry_u32x64<WBN, P>::wide_bignum_type wide_mgry_u32x64<WBN, P>::wide_R_p = zext_u32x64(WBN{mgry_constants<WBN, P>::R_p});
+
+template <concepts::wide_bignum WBN, concepts::bignum_cst P>
+const typename wide_mgry_u32x64<WBN, P>::wide_bignum_type wide_mgry_u32x64<WBN, P>::wide_Rsq_p = zext_u32x64(WBN{mgry_constants<WBN, P>::Rsq_p});
+
+namespace concepts {
+template <class T>
+concept wide_mgry_u32x64 = std::same_as<T, wide_mgry_u32x64<typename T::classical_type, typename T::P_type>>;
+} // concepts
+
+// a+b and a+b-p (or a-b+p and a-b) are computed and normalized
+// independently, and the sign of the latter selects the result.
+
+template <concepts::wide_mgry_u32x64 WMBN>
+WMBN mgry_add(WMBN const& a, WMBN const& b) {
+  using WD = typename WMBN::wide_bignum_type;
+  constexpr auto ndigits = bn_nlimbs<WD>;
+  const auto& wide_P_zext = WMBN::constants_type::wide_P_zext;
+
+  WD sum, diff;
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    eve::get<i>(sum) = eve::get<i>(a.wbn()) + eve::get<i>(b.wbn());
+    eve::get<i>(diff) = eve::get<i>(sum) - eve::get<i>(wide_P_zext);
+  });
+  propagate_u32_zext<false>(sum);
+  const auto below = wide_is_msb_set(propagate_u32_zext<true>(diff));
+
+  WD ret;
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    eve::get<i>(ret) = eve::if_else(below, eve::get<i>(sum), eve::get<i>(diff));
+  });
+  return WMBN{ret};
+}
+
+template <concepts::wide_mgry_u32x64 WMBN>
+WMBN mgry_sub(WMBN const& a, WMBN const& b) {
+  using WD = typename WMBN::wide_bignum_type;
+  constexpr auto ndigits = bn_nlimbs<WD>;
+  const auto& wide_P_zext = WMBN::constants_type::wide_P_zext;
+
+  WD diff, sum;
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    eve::get<i>(diff) = eve::get<i>(a.wbn()) - eve::get<i>(b.wbn());
+    eve::get<i>(sum) = eve::get<i>(diff) + eve::get<i>(wide_P_zext);
+  });
+  propagate_u32_zext<true>(sum);
+  const auto below = wide_is_msb_set(propagate_u32_zext<true>(diff));
+
+  WD ret;
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    eve::get<i>(ret) = eve::if_else(below, eve::get<i>(sum), eve::get<i>(diff));
+  });
+  return WMBN{ret};
+}
+
+template <concepts::wide_mgry_u32x64 WMBN>
+WMBN mgry_neg(WMBN const& a) {
+  return mgry_sub(WMBN{eve::zero(eve::as(a.wbn()))}, a);
+}
+
+template <size_t Count, concepts::wide_mgry_u32x64 WMBN>
+WMBN mgry_shift_left(WMBN const& a) {
+  static_assert(Count > 0);
+  WMBN ret = mgry_add(a, a);
+#pragma unroll
+  for (size_t i = 1; i < Count; ++i) {
+    ret = mgry_add(ret, ret);
+  }
+  return ret;
+}
+
+template <concepts::wide_mgry_u32x64 WMBN>
+[[gnu::flatten]] WMBN mgry_mul(WMBN const& a, WMBN const& b) {
+  using P = typename WMBN::P_type;
+  return WMBN{details::u32x64_mgry_finish<P>(details::mgry_mul_u32_zext<P>(a.wbn(), b.wbn()))};
+}
+
+template <concepts::wide_mgry_u32x64 WMBN>
+[[gnu::flatten]] WMBN mgry_sqr(WMBN const& v) {
+  using P = typename WMBN::P_type;
+  return WMBN{details::u32x64_mgry_finish<P>(details::mgry_sqr_u32_zext<P>(v.wbn()))};
+}
+
+template <concepts::wide_mgry_u32x64 WMBN>
+WMBN operator+(WMBN const& a, WMBN const& b) {
+  return mgry_add(a,b);
+}
+
+template <concepts::wide_mgry_u32x64 WMBN>
+WMBN operator-(WMBN const& a, WMBN const& b) {
+  return mgry_sub(a,b);
+}
+
+template <concepts::wide_mgry_u32x64 WMBN>
+WMBN operator*(WMBN const& a, WMBN const& b) {
+  return mgry_mul(a,b);
+}
+
+} // ecsimd
+
+#endif
@@ -0,0 +1,443 @@
+#ifndef ECSIMD_MGRY_UNSAT_H
+#define ECSIMD_MGRY_UNSAT_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mgry.h>
+#include <ecsimd/utility.h>
+
+#include <ctbignum/addition.hpp>
+#include <ctbignum/division.hpp>
+#include <ctbignum/mult.hpp>
+#include <ctbignum/slicing.hpp>
+
+#include <eve/wide.hpp>
+#include <eve/function/if_else.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace ecsimd {
+
+// Montgomery arithmetic over unsaturated radix 2**RadixBits digits, with R =
+// 2**(RadixBits*ndigits). Each digit is stored in a 64-bit lane. The
+// almost Montgomery multiplication is specific to each radix, and provided
+// by a specialization of details::unsat_radix (see mgry_r52.h and
+// mgry_r29.h), which also tells whether lazy additions and shifts propagate
+// carries.
+
+namespace details {
+
+template <size_t RadixBits>
+struct unsat_radix;
+
+template <size_t RadixBits>
+static constexpr uint64_t unsat_mask = (uint64_t{1} << RadixBits) - 1;
+
+template <size_t RadixBits, size_t NLimbs>
+static constexpr size_t unsat_ndigits = (NLimbs*64 + RadixBits-1)/RadixBits;
+
+// 2**k % p
+template <size_t N, class T>
+constexpr auto pow2_mod(cbn::big_int<N, T> const& p, size_t k) {
+  cbn::big_int<N, T> ret{1};
+  for (size_t i = 0; i < k; ++i) {
+    ret = cbn::mod_add(ret, ret, p);
+  }
+  return ret;
+}
+
+template <size_t RadixBits, size_t NDigits, concepts::bignum BN>
+constexpr auto bn_to_unsat(BN const& v) {
+  static_assert(std::is_same_v<bn_limb_t<BN>, uint64_t>);
+  constexpr auto nlimbs = bn_nlimbs<BN>;
+  const auto c = v.cbn();
+  cbn::big_int<NDigits, uint64_t> ret{};
+  for (size_t d = 0; d < NDigits; ++d) {
+    const size_t bit = d*RadixBits;
+    const size_t l = bit/64;
+    const size_t off = bit%64;
+    if (l >= nlimbs) {
+      continue;
+    }
+    uint64_t v = c[l] >> off;
+    if (off > 64-RadixBits && (l+1) < nlimbs) {
+      v |= c[l+1] << (64-off);
+    }
+    ret[d] = v & unsat_mask<RadixBits>;
+  }
+  return bignum<uint64_t, NDigits>::from(ret);
+}
+
+// floor(2**(RadixBits*NDigits) / p), saturated to 2**16
+template <size_t RadixBits, size_t NDigits, size_t N, class T>
+constexpr size_t unsat_lazy_max_bound(cbn::big_int<N, T> const& p) {
+  constexpr size_t bits = RadixBits*NDigits;
+  constexpr size_t max = size_t{1} << 16;
+  const auto R = cbn::detail::place_at<bits/64 + 1>(uint64_t{1} << (bits%64), bits/64);
+  const auto q = cbn::div(R, p).quotient;
+  for (size_t i = 1; i < q.size(); ++i) {
+    if (q[i] != 0) {
+      return max;
+    }
+  }
+  return std::min<size_t>(q[0], max);
+}
+
+// -p**-1 % 2**RadixBits
+template <size_t RadixBits>
+constexpr uint64_t unsat_mprime(uint64_t p0) {
+  uint64_t inv = p0;
+  for (size_t i = 0; i < 6; ++i) {
+    inv *= 2 - p0*inv;
+  }
+  return (-inv) & unsat_mask<RadixBits>;
+}
+
+} // details
+
+template <concepts::bignum_cst P, class Cardinal, size_t RadixBits>
+struct mgry_unsat_constants {
+  using BN = bn_t<P>;
+  static constexpr size_t radix_bits = RadixBits;
+  static constexpr size_t ndigits = details::unsat_ndigits<RadixBits, bn_nlimbs<BN>>;
+  using digits_type = bignum<uint64_t, ndigits>;
+  using wide_digits_type = eve::wide<digits_type, Cardinal>;
+
+  static constexpr auto p = P::value.cbn();
+  static_assert((p[0] & 1) == 1, "modulus must be odd");
+
+  static constexpr auto P_digits = details::bn_to_unsat<RadixBits, ndigits>(P::value);
+  static constexpr auto R_p      = details::bn_to_unsat<RadixBits, ndigits>(BN::from(details::pow2_mod(p, RadixBits*ndigits)));
+  static constexpr auto Rsq_p    = details::bn_to_unsat<RadixBits, ndigits>(BN::from(details::pow2_mod(p, 2*RadixBits*ndigits)));
+  static constexpr uint64_t mprime = details::unsat_mprime<RadixBits>(p[0]);
+
+  // Values up to lazy_max_bound*p fit in ndigits digits (see gfp_lazy.h)
+  static constexpr size_t lazy_max_bound = details::unsat_lazy_max_bound<RadixBits, ndigits>(p);
+
+  // K*p
+  template <size_t K>
+  static constexpr auto P_mul = details::bn_to_unsat<RadixBits, ndigits>(
+    bignum<uint64_t, bn_nlimbs<BN>+1>::from(cbn::mul(p, cbn::big_int<1, uint64_t>{K})));
+};
+
+namespace details {
+
+template <size_t RadixBits, concepts::wide_bignum WBN>
+static auto unsat_from_wbn(WBN const& n)
+{
+  using cardinal = eve::cardinal_t<WBN>;
+  using WL = eve::wide<uint64_t, cardinal>;
+  constexpr auto nlimbs = bn_nlimbs<WBN>;
+  constexpr auto ndigits = unsat_ndigits<RadixBits, nlimbs>;
+  static_assert(std::is_same_v<bn_limb_t<WBN>, uint64_t>);
+
+  const WL mask{unsat_mask<RadixBits>};
+  eve::wide<bignum<uint64_t, ndigits>, cardinal> ret;
+  eve::detail::for_<0,1,ndigits>([&](auto d_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto d = decltype(d_)::value;
+    constexpr auto l = (d*RadixBits)/64;
+    constexpr auto off = (d*RadixBits)%64;
+    WL v = eve::get<l>(n) >> off;
+    if constexpr (off > 64-RadixBits && (l+1) < nlimbs) {
+      v |= eve::get<l+1>(n) << (64-off);
+    }
+    eve::get<d>(ret) = v & mask;
+  });
+  return ret;
+}
+
+// Digits must be normalized (< 2**RadixBits)
+template <size_t RadixBits, concepts::wide_bignum WBN, concepts::wide_bignum WD>
+static auto unsat_to_wbn(WD const& v)
+{
+  using cardinal = eve::cardinal_t<WBN>;
+  using WL = eve::wide<uint64_t, cardinal>;
+  constexpr auto nlimbs = bn_nlimbs<WBN>;
+  constexpr auto ndigits = bn_nlimbs<WD>;
+
+  WBN ret;
+  eve::detail::for_<0,1,nlimbs>([&](auto l_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto l = decltype(l_)::value;
+    constexpr auto dbegin = (l*64)/RadixBits;
+    constexpr auto dend = std::min<size_t>((l*64+63)/RadixBits + 1, ndigits);
+    auto limb = eve::zero(eve::as<WL>());
+    eve::detail::for_<dbegin,1,dend>([&](auto d_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto d = decltype(d_)::value;
+      constexpr auto bit = d*RadixBits;
+      if constexpr (bit >= l*64) {
+        limb |= eve::get<d>(v) << (bit - l*64);
+      }
+      else {
+        limb |= eve::get<d>(v) >> (l*64 - bit);
+      }
+    });
+    eve::get<l>(ret) = limb;
+  });
+  return ret;
+}
+
+// Propagates carries so that every digit but the last one is <
+// 2**RadixBits. If Signed is true, digits are considered as signed 64-bit
+// integers.
+template <size_t RadixBits, bool Signed, concepts::wide_bignum WD>
+static auto unsat_normalize(WD v)
+{
+  using cardinal = eve::cardinal_t<WD>;
+  using WL = eve::wide<uint64_t, cardinal>;
+  constexpr auto ndigits = bn_nlimbs<WD>;
+
+  const WL mask{unsat_mask<RadixBits>};
+  eve::detail::for_<1,1,ndigits>([&](auto d_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto d = decltype(d_)::value;
+    const auto prev = eve::get<d-1>(v);
+    if constexpr (Signed) {
+      eve::get<d>(v) += wide_uasr(prev, RadixBits);
+    }
+    else {
+      eve::get<d>(v) += prev >> RadixBits;
+    }
+    eve::get<d-1>(v) = prev & mask;
+  });
+  return v;
+}
+
+// Returns v-K*p if v >= K*p, else v. v must be normalized and < 2*K*p.
+template <concepts::bignum_cst P, size_t RadixBits, size_t K = 1, concepts::wide_bignum WD>
+static auto unsat_sub_if_above(WD const& v)
+{
+  using cardinal = eve::cardinal_t<WD>;
+  using WL = eve::wide<uint64_t, cardinal>;
+  using csts = mgry_unsat_constants<P, cardinal, RadixBits>;
+  constexpr auto ndigits = bn_nlimbs<WD>;
+
+  WD diff;
+  eve::detail::for_<0,1,ndigits>([&](auto d_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto d = decltype(d_)::value;
+    eve::get<d>(diff) = eve::get<d>(v) - WL{kumi::get<d>(csts::template P_mul<K>)};
+  });
+  diff = unsat_normalize<RadixBits, true>(diff);
+
+  const auto below = wide_is_msb_set(eve::get<ndigits-1>(diff));
+  WD ret;
+  eve::detail::for_<0,1,ndigits>([&](auto d_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto d = decltype(d_)::value;
+    eve::get<d>(ret) = eve::if_else(below, eve::get<d>(v), eve::get<d>(diff));
+  });
+  return ret;
+}
+
+// Returns v % p. v must be < Bound*p, and normalized if Normalized is true.
+template <concepts::bignum_cst P, size_t RadixBits, size_t Bound, bool Normalized, concepts::wide_bignum WD>
+static auto unsat_reduce(WD const& v)
+{
+  if constexpr (!Normalized) {
+    return unsat_reduce<P, RadixBits, Bound, true>(unsat_normalize<RadixBits, false>(v));
+  }
+  else if constexpr (Bound > 1) {
+    constexpr size_t K = std::bit_floor(Bound-1);
+    return unsat_reduce<P, RadixBits, K, true>(unsat_sub_if_above<P, RadixBits, K>(v));
+  }
+  else {
+    return v;
+  }
+}
+
+template <concepts::bignum_cst P, size_t RadixBits, concepts::wide_bignum WD>
+static auto unsat_mgry_mul(WD const& a, WD const& b)
+{
+  using radix = unsat_radix<RadixBits>;
+  return unsat_sub_if_above<P, RadixBits>(
+    unsat_normalize<RadixBits, false>(radix::template amm<P>(a, b)));
+}
+
+} // details
+
+template <concepts::wide_bignum WBN, concepts::bignum_cst P, size_t RadixBits>
+struct wide_mgry_unsat
+{
+  using classical_type = WBN;
+  using P_type = P;
+  using constants_type = mgry_unsat_constants<P, eve::cardinal_t<WBN>, RadixBits>;
+  using wide_bignum_type = typename constants_type::wide_digits_type;
+  using bignum_type = typename wide_bignum_type::value_type;
+
+  static constexpr size_t radix_bits = RadixBits;
+  static constexpr size_t lazy_max_bound = constants_type::lazy_max_bound;
+
+  wide_mgry_unsat() = default;
+
+  wide_mgry_unsat(wide_bignum_type const& n):
+    n_(n)
+  { }
+
+  static wide_mgry_unsat R() {
+    return wide_mgry_unsat{wide_bignum_type{constants_type::R_p}};
+  }
+
+  static wide_mgry_unsat from_classical(WBN const& n) {
+    const auto d = details::unsat_from_wbn<RadixBits>(n);
+    return wide_mgry_unsat{details::unsat_mgry_mul<P, RadixBits>(d, wide_bignum_type{constants_type::Rsq_p})};
+  }
+
+  WBN to_classical() const {
+    const auto one = wide_bignum_type{bignum_type::from(1)};
+    return details::unsat_to_wbn<RadixBits, WBN>(details::unsat_mgry_mul<P, RadixBits>(n_, one));
+  }
+
+  wide_bignum_type const& wbn() const { return n_; }
+  wide_bignum_type& wbn() { return n_; }
+
+private:
+  wide_bignum_type n_;
+};
+
+namespace concepts {
+template <class T>
+concept wide_mgry_unsat = std::same_as<T, wide_mgry_unsat<typename T::classical_type, typename T::P_type, T::radix_bits>>;
+} // concepts
+
+// Lazy operations: if a < Ba*p and b < Bb*p, then mgry_add_lazy(a,b) <
+// (Ba+Bb)*p, mgry_sub_lazy<Bb>(a,b) < (Ba+Bb)*p,
+// mgry_shift_left_lazy<Count>(a) < Ba*2**Count*p and mgry_mul_lazy(a,b) <
+// (Ba*Bb*p/R + 1)*p. Callers must make sure these bounds stay below
+// lazy_max_bound*p (see gfp_lazy.h).
+//
+// Results are not reduced. If the radix defers carries, lazy additions and
+// shifts do not normalize their results either: if a and b have digits lower
+// than Ba*2**RadixBits and Bb*2**RadixBits, the digits of a+b are lower than
+// (Ba+Bb)*2**RadixBits. They thus always fit in 64 bits, as bounds are lower
+// than 2**16. Subtractions, multiplications and reductions always normalize.
+
+template <concepts::wide_mgry_unsat WMBN>
+WMBN mgry_add_lazy(WMBN const& a, WMBN const& b) {
+  constexpr auto ndigits = WMBN::constants_type::ndigits;
+  constexpr auto radix_bits = WMBN::radix_bits;
+  typename WMBN::wide_bignum_type sum;
+  eve::detail::for_<0,1,ndigits>([&](auto d_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto d = decltype(d_)::value;
+    eve::get<d>(sum) = eve::get<d>(a.wbn()) + eve::get<d>(b.wbn());
+  });
+  if constexpr (details::unsat_radix<radix_bits>::deferred_carries) {
+    return WMBN{sum};
+  }
+  else {
+    return WMBN{details::unsat_normalize<radix_bits, false>(sum)};
+  }
+}
+
+// a-b+K*p, with b < K*p. The result is normalized.
+template <size_t K, concepts::wide_mgry_unsat WMBN>
+WMBN mgry_sub_lazy(WMBN const& a, WMBN const& b) {
+  using constants_type = typename WMBN::constants_type;
+  using WL = eve::wide<uint64_t, eve::cardinal_t<typename WMBN::wide_bignum_type>>;
+  constexpr auto ndigits = constants_type::ndigits;
+  typename WMBN::wide_bignum_type diff;
+  eve::detail::for_<0,1,ndigits>([&](auto d_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto d = decltype(d_)::value;
+    eve::get<d>(diff) = eve::get<d>(a.wbn()) - eve::get<d>(b.wbn()) +
+      WL{kumi::get<d>(constants_type::template P_mul<K>)};
+  });
+  return WMBN{details::unsat_normalize<WMBN::radix_bits, true>(diff)};
+}
+
+template <size_t Count, concepts::wide_mgry_unsat WMBN>
+WMBN mgry_shift_left_lazy(WMBN const& a) {
+  constexpr auto ndigits = WMBN::constants_type::ndigits;
+  constexpr auto radix_bits = WMBN::radix_bits;
+  static_assert(Count > 0 && Count < 16 && Count < 64-radix_bits);
+  typename WMBN::wide_bignum_type ret;
+  eve::detail::for_<0,1,ndigits>([&](auto d_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto d = decltype(d_)::value;
+    eve::get<d>(ret) = eve::get<d>(a.wbn()) << Count;
+  });
+  if constexpr (details::unsat_radix<radix_bits>::deferred_carries) {
+    return WMBN{ret};
+  }
+  else {
+    return WMBN{details::unsat_normalize<radix_bits, false>(ret)};
+  }
+}
+
+// If the radix defers carries, operands are normalized first, so that
+// their digits fit in RadixBits bits.
+template <concepts::wide_mgry_unsat WMBN>
+[[gnu::flatten]] WMBN mgry_mul_lazy(WMBN const& a, WMBN const& b) {
+  using P = typename WMBN::P_type;
+  constexpr auto radix_bits = WMBN::radix_bits;
+  using radix = details::unsat_radix<radix_bits>;
+  if constexpr (radix::deferred_carries) {
+    const auto an = details::unsat_normalize<radix_bits, false>(a.wbn());
+    const auto bn = details::unsat_normalize<radix_bits, false>(b.wbn());
+    return WMBN{details::unsat_normalize<radix_bits, false>(radix::template amm<P>(an, bn))};
+  }
+  else {
+    return WMBN{details::unsat_normalize<radix_bits, false>(radix::template amm<P>(a.wbn(), b.wbn()))};
+  }
+}
+
+// a % p, with a < Bound*p
+template <size_t Bound, concepts::wide_mgry_unsat WMBN>
+WMBN mgry_reduce_lazy(WMBN const& a) {
+  constexpr auto radix_bits = WMBN::radix_bits;
+  return WMBN{details::unsat_reduce<typename WMBN::P_type, radix_bits, Bound,
+    !details::unsat_radix<radix_bits>::deferred_carries>(a.wbn())};
+}
+
+template <concepts::wide_mgry_unsat WMBN>
+WMBN mgry_add(WMBN const& a, WMBN const& b) {
+  return mgry_reduce_lazy<2>(mgry_add_lazy(a, b));
+}
+
+// a-b+p is in ]0, 2p[
+template <concepts::wide_mgry_unsat WMBN>
+WMBN mgry_sub(WMBN const& a, WMBN const& b) {
+  return WMBN{details::unsat_sub_if_above<typename WMBN::P_type, WMBN::radix_bits>(
+    mgry_sub_lazy<1>(a, b).wbn())};
+}
+
+template <concepts::wide_mgry_unsat WMBN>
+WMBN mgry_neg(WMBN const& a) {
+  return mgry_sub(WMBN{eve::zero(eve::as(a.wbn()))}, a);
+}
+
+template <size_t Count, concepts::wide_mgry_unsat WMBN>
+WMBN mgry_shift_left(WMBN const& a) {
+  static_assert(Count > 0);
+  WMBN ret = mgry_add(a, a);
+#pragma unroll
+  for (size_t i = 1; i < Count; ++i) {
+    ret = mgry_add(ret, ret);
+  }
+  return ret;
+}
+
+template <concepts::wide_mgry_unsat WMBN>
+[[gnu::flatten]] WMBN mgry_mul(WMBN const& a, WMBN const& b) {
+  return WMBN{details::unsat_mgry_mul<typename WMBN::P_type, WMBN::radix_bits>(a.wbn(), b.wbn())};
+}
+
+template <concepts::wide_mgry_unsat WMBN>
+[[gnu::flatten]] WMBN mgry_sqr(WMBN const& v) {
+  return mgry_mul(v, v);
+}
+
+template <concepts::wide_mgry_unsat WMBN>
+WMBN operator+(WMBN const& a, WMBN const& b) {
+  return mgry_add(a,b);
+}
+
+template <concepts::wide_mgry_unsat WMBN>
+WMBN operator-(WMBN const& a, WMBN const& b) {
+  return mgry_sub(a,b);
+}
+
+template <concepts::wide_mgry_unsat WMBN>
+WMBN operator*(WMBN const& a, WMBN const& b) {
+  return mgry_mul(a,b);
+}
+
+} // ecsimd
+
+#endif
@@ -7,6 +7,7 @@
 #include <eve/traits/cardinal.hpp>
 
 #include <ecsimd/bignum.h>
+#include <ecsimd/utility.h>
 
 #include <immintrin.h>
 
@@ -53,12 +54,100 @@ static auto sqr_wide(eve::wide<uint32_t, eve::fixed<4>> const a) {
 #endif
 }
 
-static auto mullow(eve::wide<uint64_t, eve::fixed<4>> const a, eve::wide<uint64_t, eve::fixed<4>> const b) {
-  const __m256i a_ = std::bit_cast<__m256i>(a);
-  const __m256i b_ = std::bit_cast<__m256i>(b);
-  const __m256i ret = _mm256_mul_epu32(a_, b_);
-  return std::bit_cast<eve::wide<uint64_t, eve::fixed<4>>>(ret);
+// Multiplies the lowest 32 bits of each 64-bit lane (vpmuludq)
+template <class C>
+static auto mullow(eve::wide<uint64_t, C> const a, eve::wide<uint64_t, C> const b) {
+  using W = eve::wide<uint64_t, C>;
+  if constexpr (eve::has_aggregated_abi_v<W>) {
+    const auto [al, ah] = a.slice();
+    const auto [bl, bh] = b.slice();
+    return W{mullow(al, bl), mullow(ah, bh)};
+  }
+#ifdef __AVX512F__
+  else if constexpr (sizeof(W) == 64) {
+    return std::bit_cast<W>(_mm512_mul_epu32(std::bit_cast<__m512i>(a), std::bit_cast<__m512i>(b)));
+  }
+#endif
+#ifdef __AVX2__
+  else if constexpr (sizeof(W) == 32) {
+    return std::bit_cast<W>(_mm256_mul_epu32(std::bit_cast<__m256i>(a), std::bit_cast<__m256i>(b)));
+  }
+#endif
+  else if constexpr (sizeof(W) == 16) {
+    return std::bit_cast<W>(_mm_mul_epu32(std::bit_cast<__m128i>(a), std::bit_cast<__m128i>(b)));
+  }
+  else {
+    const W low_mask{std::numeric_limits<uint32_t>::max()};
+    return (a & low_mask) * (b & low_mask);
+  }
+}
+
+// Multiplies the lowest 32 bits of each 64-bit lane, as signed integers
+// (vpmuldq). Lanes hold 64-bit two's complement values.
+template <class C>
+static auto mullow_signed(eve::wide<uint64_t, C> const a, eve::wide<uint64_t, C> const b) {
+  using W = eve::wide<uint64_t, C>;
+  if constexpr (eve::has_aggregated_abi_v<W>) {
+    const auto [al, ah] = a.slice();
+    const auto [bl, bh] = b.slice();
+    return W{mullow_signed(al, bl), mullow_signed(ah, bh)};
+  }
+#ifdef __AVX512F__
+  else if constexpr (sizeof(W) == 64) {
+    return std::bit_cast<W>(_mm512_mul_epi32(std::bit_cast<__m512i>(a), std::bit_cast<__m512i>(b)));
+  }
+#endif
+#ifdef __AVX2__
+  else if constexpr (sizeof(W) == 32) {
+    return std::bit_cast<W>(_mm256_mul_epi32(std::bit_cast<__m256i>(a), std::bit_cast<__m256i>(b)));
+  }
+#endif
+#ifdef __SSE4_1__
+  else if constexpr (sizeof(W) == 16) {
+    return std::bit_cast<W>(_mm_mul_epi32(std::bit_cast<__m128i>(a), std::bit_cast<__m128i>(b)));
+  }
+#endif
+  else {
+    return W{[&](auto i, auto) {
+      return uint64_t(int64_t(int32_t(uint32_t(a.get(i)))) * int64_t(int32_t(uint32_t(b.get(i)))));
+    }};
+  }
+}
+
+namespace details {
+// Returns the lowest 32 bits of each lane of lo, with the lowest 32 bits of
+// hi as upper 32 bits.
+template <class C>
+static auto blend_u32x64(eve::wide<uint64_t, C> const lo, eve::wide<uint64_t, C> const hi) {
+  using W = eve::wide<uint64_t, C>;
+  constexpr auto half_bits = std::numeric_limits<uint32_t>::digits;
+  if constexpr (eve::has_aggregated_abi_v<W>) {
+    const auto [ll, lh] = lo.slice();
+    const auto [hl, hh] = hi.slice();
+    return W{blend_u32x64(ll, hl), blend_u32x64(lh, hh)};
+  }
+#ifdef __AVX512F__
+  else if constexpr (sizeof(W) == 64) {
+    const auto hi_ = std::bit_cast<__m512i>(hi << half_bits);
+    return std::bit_cast<W>(_mm512_mask_blend_epi32(0xAAAA, std::bit_cast<__m512i>(lo), hi_));
+  }
+#endif
+#ifdef __AVX2__
+  else if constexpr (sizeof(W) == 32) {
+    const auto hi_ = std::bit_cast<__m256i>(hi << half_bits);
+    return std::bit_cast<W>(_mm256_blend_epi32(std::bit_cast<__m256i>(lo), hi_, 0b10101010));
+  }
+  else if constexpr (sizeof(W) == 16) {
+    const auto hi_ = std::bit_cast<__m128i>(hi << half_bits);
+    return std::bit_cast<W>(_mm_blend_epi32(std::bit_cast<__m128i>(lo), hi_, 0b1010));
+  }
+#endif
+  else {
+    const W low_mask{std::numeric_limits<uint32_t>::max()};
+    return (lo & low_mask) | (hi << half_bits);
+  }
 }
+} // details
 
 template <concepts::wide_bignum WBN>
 static auto zext_u32x64(WBN const& v)
@@ -89,29 +178,47 @@ static auto trunc_u64x32(WBN const& v)
   using cardinal = eve::cardinal_t<WBN>;
   constexpr size_t nlimbs = bn_nlimbs<WBN>;
   static_assert(nlimbs % 2 == 0);
-  using half_limb_type = eve::detail::downgrade_t<limb_type>;
 
-  using wide_limb_type = eve::wide<limb_type, cardinal>;
   using ret_type = eve::wide<bignum<limb_type, nlimbs/2>, cardinal>;
 
-  // TODO: generate (true,false)*(cardinal/2) at compile-time
-  //const auto lm = eve::as_logical_t<>{true, false, true, false};
-
   auto ret = eve::zero(eve::as<ret_type>());
   eve::detail::for_<0, 1, nlimbs/2>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
     constexpr auto i = decltype(i_)::value;
-    const auto l0 = eve::get<2*i>(v);
-    const auto l1 = eve::get<2*i+1>(v);
-
-    // TODO: generalize
-    const auto l0_ = std::bit_cast<__m256i>(l0);
-    const auto l1_ = std::bit_cast<__m256i>(l1 << std::numeric_limits<half_limb_type>::digits);
-    const auto l_  = _mm256_blend_epi32(l0_, l1_, 0b10101010);
-    eve::get<i>(ret) = std::bit_cast<wide_limb_type>(l_);
+    eve::get<i>(ret) = details::blend_u32x64(eve::get<2*i>(v), eve::get<2*i+1>(v));
   });
   return ret;
 }
 
+// Propagates carries through zero-extended 32-bit digits, and returns the
+// carry out of the last digit. If Signed, digits are considered as signed
+// values, and the returned carry can be negative.
+template <bool Signed, concepts::wide_bignum WD>
+static auto propagate_u32_zext(WD& v)
+{
+  using limb_type = bn_limb_t<WD>;
+  using half_limb_type = eve::detail::downgrade_t<limb_type>;
+  using WL = eve::wide<limb_type, eve::cardinal_t<WD>>;
+  constexpr auto half_nbits = std::numeric_limits<half_limb_type>::digits;
+  const WL low_mask(std::numeric_limits<half_limb_type>::max());
+
+  WL carry;
+  eve::detail::for_<0,1,bn_nlimbs<WD>>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    auto d = eve::get<i>(v);
+    if constexpr (i > 0) {
+      d += carry;
+    }
+    if constexpr (Signed) {
+      carry = wide_uasr(d, half_nbits);
+    }
+    else {
+      carry = d >> half_nbits;
+    }
+    eve::get<i>(v) = d & low_mask;
+  });
+  return carry;
+}
+
 template <concepts::wide_bignum WBN>
 static auto
   mul_u32_zext(WBN const& a, WBN const& b)
@@ -157,6 +264,9 @@ static auto
   return trunc_u64x32(m);
 }
 
+// a**2, with a as zero-extended 32-bit digits, in product scanning form. The
+// cross products are added once and doubled, in split accumulators holding
+// their low and high 32-bit halves, so that no carry is lost.
 template <concepts::wide_bignum WBN>
 static auto
   square_u32_zext(WBN const& a)
@@ -169,44 +279,34 @@ static auto
   using WL = eve::wide<limb_type, cardinal>;
   using ret_type = eve::wide<bignum<limb_type, nlimbs*2>, cardinal>;
 
-  auto ret = eve::zero(eve::as<ret_type>());
-  const eve::wide<limb_type, cardinal> low_mask(std::numeric_limits<half_limb_type>::max());
-
-  // Compute the cross products
-  eve::detail::for_<0,1,nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
-    constexpr auto i = decltype(i_)::value;
-
-    const auto la = eve::get<i>(a);
-    auto t = mullow(la, la);
-    t += eve::get<2*i>(ret);
-    eve::get<2*i>(ret) = t & low_mask;
-
-    WL prevs[2];
-    prevs[0] = t >> half_limb_bits;
-    prevs[1] = eve::zero(eve::as<WL>());
-
-    eve::detail::for_<i+1,1,nlimbs>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
-      constexpr auto j = decltype(j_)::value;
-      static_assert(i != j);
-      constexpr auto retlimb = i+j;
-
-      auto t = mullow(eve::get<i>(a), eve::get<j>(a));
-      const auto carry = t >> ((2*half_limb_bits)-1);
-      t <<= 1;
-      t += eve::get<retlimb>(ret);
-      t += prevs[0];
-
-      eve::get<retlimb>(ret) = t & low_mask;
-
-      prevs[0] = prevs[1];
-      prevs[0] += t >> half_limb_bits;
-      prevs[1] = carry;
+  ret_type ret;
+  const WL low_mask(std::numeric_limits<half_limb_type>::max());
+
+  WL acc_lo = eve::zero(eve::as<WL>());
+  WL acc_hi = eve::zero(eve::as<WL>());
+  eve::detail::for_<0,1,2*nlimbs>([&](auto k_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto k = decltype(k_)::value;
+    constexpr auto imin = k < nlimbs ? 0 : k-nlimbs+1;
+
+    WL cross_lo = eve::zero(eve::as<WL>());
+    WL cross_hi = eve::zero(eve::as<WL>());
+    eve::detail::for_<imin,1,(k+1)/2>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto i = decltype(i_)::value;
+      const auto x = mullow(eve::get<i>(a), eve::get<k-i>(a));
+      cross_lo += x & low_mask;
+      cross_hi += x >> half_limb_bits;
     });
-
-    eve::get<i+nlimbs>(ret) += prevs[0]; // TODO: carry?
-    if constexpr ((i+nlimbs+1) < (2*nlimbs)) {
-      eve::get<i+nlimbs+1>(ret) = prevs[1];
+    acc_lo += cross_lo << 1;
+    acc_hi += cross_hi << 1;
+    if constexpr (k % 2 == 0) {
+      const auto x = mullow(eve::get<k/2>(a), eve::get<k/2>(a));
+      acc_lo += x & low_mask;
+      acc_hi += x >> half_limb_bits;
     }
+
+    eve::get<k>(ret) = acc_lo & low_mask;
+    acc_lo = (acc_lo >> half_limb_bits) + acc_hi;
+    acc_hi = eve::zero(eve::as<WL>());
   });
   return ret;
 }
@@ -0,0 +1,132 @@
+#ifndef ECSIMD_MUL_SMALL_H
+#define ECSIMD_MUL_SMALL_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mgry.h>
+#include <ecsimd/mgry_csts.h>
+#include <ecsimd/mgry_mul.h>
+#include <ecsimd/mgry_ops.h>
+#include <ecsimd/mul.h>
+#include <ecsimd/special_form.h>
+
+#include <ctbignum/mult.hpp>
+#include <ctbignum/relational_ops.hpp>
+#include <ctbignum/slicing.hpp>
+
+#include <eve/wide.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+namespace ecsimd {
+
+// Multiplication by a small constant K modulo P. As K*(a*R) = (K*a)*R, the
+// same kernel works for every representation that stores its numbers as
+// plain integers lower than p (Montgomery, special form, Barrett).
+//
+// K*a is computed over 32-bit digits (see zext_u32x64), and the quotient by
+// 2**N (N the number of bits of the bignum type) is estimated from the most
+// significant digit only: q = (K*a[n-1]) >> 32. K*a - q*p is then computed in
+// the same multiply-accumulate pass, and is lower than 2**N + q*(2**N-p) +
+// K*2**(N-32), so that a single conditional subtraction is enough for primes
+// close to 2**N (like the curve ones). Other primes (and representations)
+// chain mgry_add and mgry_shift_left.
+
+template <uint64_t K, concepts::bignum_cst P>
+struct mul_small_constants {
+  using BN = bn_t<P>;
+  static_assert(std::is_same_v<bn_limb_t<BN>, uint64_t>);
+  static constexpr size_t nlimbs = bn_nlimbs<BN>;
+  static constexpr size_t ndigits = 2*nlimbs;
+  static_assert(K >= 1 && K < (uint64_t{1} << 31));
+
+  static constexpr auto p = P::value.cbn();
+
+  // K*a - q*p < 2p if K*(2**N + 2**(N-32)) <= (K+1)*p
+  static constexpr bool single_correction = []() {
+    auto bound = cbn::detail::unary_encoding<nlimbs, nlimbs+1>();
+    bound[nlimbs-1] = uint64_t{1} << 32;
+    return cbn::short_mul(bound, K) <= cbn::short_mul(cbn::detail::pad<1>(p), K+1);
+  }();
+};
+
+namespace details {
+
+// K*a mod P, with a as zero-extended 32-bit digits. a can be any number of
+// the size of P, the result is lower than p.
+template <uint64_t K, concepts::bignum_cst P, concepts::wide_bignum WD>
+static auto mul_small_u32_zext(WD const& az)
+{
+  using csts = mul_small_constants<K, P>;
+  using cardinal = eve::cardinal_t<WD>;
+  using WL = eve::wide<uint64_t, cardinal>;
+  using WBN = eve::wide<bn_t<P>, cardinal>;
+  constexpr auto ndigits = csts::ndigits;
+  static_assert(bn_nlimbs<WD> == ndigits);
+  static_assert(csts::single_correction);
+
+  WL q = eve::zero(eve::as<WL>());
+  sf_madd<int64_t(K)>(q, eve::get<ndigits-1>(az));
+  q >>= 32;
+
+  // Digits are in ]-K*2**32, K*2**32[, and the final carry is 0 or 1
+  WD r;
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    constexpr auto pd = mgry_cst_p<P, cardinal>::digits[i];
+    WL v = eve::zero(eve::as<WL>());
+    sf_madd<int64_t(K)>(v, eve::get<i>(az));
+    if constexpr (pd == 1) {
+      v -= q;
+    }
+    else if constexpr (pd != 0) {
+      v -= mullow(q, WL{pd});
+    }
+    eve::get<i>(r) = v;
+  });
+  const auto top = propagate_u32_zext<true>(r);
+  return u32x64_sub_if_above(r, mgry_constants<WBN, P>::wide_P_zext, top);
+}
+
+// K*a with mgry_add and mgry_shift_left
+template <uint64_t K, concepts::mgry_repr WMBN>
+static WMBN mgry_mul_small_chain(WMBN const& a) {
+  if constexpr (K == 1) {
+    return a;
+  }
+  else if constexpr (std::has_single_bit(K)) {
+    return mgry_shift_left<std::countr_zero(K)>(a);
+  }
+  else {
+    return mgry_add(mgry_mul_small_chain<K-1>(a), a);
+  }
+}
+
+} // details
+
+// K*a [p], for any representation of a
+template <uint64_t K, concepts::mgry_repr WMBN>
+WMBN mgry_mul_small(WMBN const& a) {
+  using P = typename WMBN::P_type;
+  using WBN = eve::wide<bn_t<P>, eve::cardinal_t<typename WMBN::wide_bignum_type>>;
+  static_assert(K >= 1);
+  // Doubling is a single shift, which is cheaper
+  if constexpr (K <= 2 || !mul_small_constants<K, P>::single_correction) {
+    return details::mgry_mul_small_chain<K>(a);
+  }
+  else if constexpr (std::is_same_v<typename WMBN::wide_bignum_type, WBN>) {
+    return WMBN{trunc_u64x32(details::mul_small_u32_zext<K, P>(zext_u32x64(a.wbn())))};
+  }
+  else if constexpr (std::is_same_v<typename WMBN::wide_bignum_type, wbn_zext_t<WBN>>) {
+    // wide_mgry_u32x64
+    return WMBN{details::mul_small_u32_zext<K, P>(a.wbn())};
+  }
+  else {
+    return details::mgry_mul_small_chain<K>(a);
+  }
+}
+
+} // ecsimd
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef ECSIMD_RSA_H
+#define ECSIMD_RSA_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/wide_digits.h>
+
+#include <algorithm>
+
+namespace ecsimd {
+
+// Batched RSA primitives (no padding), one key and one message per lane.
+// Bits is the size of the modulus n = p*q, p and q having Bits/2 bits.
+template <size_t Bits, class Cardinal = default_cardinal>
+struct wide_rsa {
+  static_assert(Bits % 128 == 0);
+
+  using bignum_type = bignum<uint64_t, Bits/64>;
+  using half_bignum_type = bignum<uint64_t, Bits/128>;
+  using WBN = wide_bignum<bignum_type, Cardinal>;
+  using WHBN = wide_bignum<half_bignum_type, Cardinal>;
+
+  static constexpr size_t ndigits = Bits/32;
+  static constexpr size_t half_ndigits = Bits/64;
+
+  // x**e mod n. e is public, and the same for every lane.
+  class public_key {
+  public:
+    explicit public_key(WBN const& n, uint64_t e = 65537):
+      ctx_(n),
+      e_(bignum<uint64_t, 1>::from(e))
+    { }
+
+    WBN apply(WBN const& x) const {
+      const auto r = ctx_.template pow<1>(ctx_.from_classical(to_digits(x)), e_);
+      return from_digits<WBN>(ctx_.to_classical(r));
+    }
+
+  private:
+    mgry_digits_context<ndigits, Cardinal> ctx_;
+    bignum<uint64_t, 1> e_;
+  };
+
+  // x**d mod n, with the CRT: dp = d mod (p-1), dq = d mod (q-1) and
+  // qinv = 1/q mod p. The exponentiations are constant time (see
+  // mgry_pow_window), and the recombination has no secret-dependent branch.
+  class private_key {
+  public:
+    private_key(WHBN const& p, WHBN const& q, WHBN const& dp, WHBN const& dq, WHBN const& qinv):
+      ctx_p_(p),
+      ctx_q_(q),
+      q_(to_digits(q)),
+      dp_(dp),
+      dq_(dq),
+      qinv_(to_digits(qinv))
+    { }
+
+    // x must be lower than n
+    WBN apply(WBN const& x) const {
+      const auto xd = to_digits(x);
+      const auto m1 = ctx_p_.template pow<5>(reduce(ctx_p_, xd), dp_);
+      const auto m2 = ctx_q_.to_classical(ctx_q_.template pow<5>(reduce(ctx_q_, xd), dq_));
+
+      // h = qinv*(m1-m2) [p]: the Montgomery multiplication by the classical
+      // qinv gets h out of the Montgomery domain. m2 < q < 2**(Bits/2).
+      const auto diff = ctx_p_.sub(m1, ctx_p_.from_classical(m2));
+      const auto h = ctx_p_.mul(diff, qinv_);
+
+      // m = m2 + h*q < n
+      const auto hq = digits_mul(h, q_);
+      digits m2z;
+      std::copy(m2.begin(), m2.end(), m2z.begin());
+      std::fill(m2z.begin()+half_ndigits, m2z.end(), eve::wide<uint64_t, Cardinal>{0});
+      const auto m = digits_add(hq, m2z);
+      digits ret;
+      std::copy(m.begin(), m.begin()+ndigits, ret.begin());
+      return from_digits<WBN>(ret);
+    }
+
+  private:
+    using digits = wide_digits<ndigits, Cardinal>;
+    using half_digits = wide_digits<half_ndigits, Cardinal>;
+    using half_ctx = mgry_digits_context<half_ndigits, Cardinal>;
+
+    // x*R [p] for x < 2**Bits: with x = hi*2**(Bits/2) + lo, this is
+    // hi*R**2 + lo*R, as Montgomery multiplications by R**2.
+    static half_digits reduce(half_ctx const& ctx, digits const& x) {
+      half_digits lo;
+      half_digits hi;
+      std::copy(x.begin(), x.begin()+half_ndigits, lo.begin());
+      std::copy(x.begin()+half_ndigits, x.end(), hi.begin());
+      const auto hiR2 = ctx.mul(ctx.mul(hi, ctx.Rsq()), ctx.Rsq());
+      return ctx.add(hiR2, ctx.mul(lo, ctx.Rsq()));
+    }
+
+    half_ctx ctx_p_;
+    half_ctx ctx_q_;
+    half_digits q_;
+    WHBN dp_;
+    WHBN dq_;
+    half_digits qinv_;
+  };
+};
+
+} // ecsimd
+
+#endif
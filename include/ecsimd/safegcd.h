@@ -0,0 +1,308 @@
+#ifndef ECSIMD_SAFEGCD_H
+#define ECSIMD_SAFEGCD_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mul.h>
+#include <ecsimd/utility.h>
+
+#include <eve/wide.hpp>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace ecsimd {
+
+// Constant-time modular inversion, based on the "safegcd" algorithm of
+// Bernstein and Yang (https://eprint.iacr.org/2019/266), following the
+// structure of libsecp256k1's modinv32: divsteps are computed in batches of
+// 30 on the lowest bits of f and g, and the resulting 2x2 transition matrix
+// is then applied to the full f, g, d and e. Numbers are stored as signed
+// radix 2**30 digits, each in a 64-bit lane, so that every product fits in a
+// signed 32x32->64 bits multiplication (see mullow_signed).
+//
+// The number of divsteps is the bound of theorem 11.2 of the paper, so that
+// every lane runs the same sequence of operations whatever its value.
+
+namespace details {
+
+static constexpr uint64_t s30_mask = (uint64_t{1} << 30) - 1;
+
+template <concepts::bignum_cst P>
+struct safegcd_constants {
+  using BN = bn_t<P>;
+  static_assert(std::is_same_v<bn_limb_t<BN>, uint64_t>);
+
+  static constexpr auto p = P::value.cbn();
+  static_assert((p[0] & 1) == 1, "modulus must be odd");
+
+  static constexpr size_t nbits = []() {
+    for (size_t i = p.size(); i > 0; --i) {
+      if (p[i-1] != 0) {
+        return 64*(i-1) + std::bit_width(p[i-1]);
+      }
+    }
+    return size_t{0};
+  }();
+
+  // One more bit for the sign
+  static constexpr size_t ndigits = (nbits + 30)/30;
+
+  static constexpr size_t ndivsteps = nbits < 46 ? (49*nbits + 80)/17 : (49*nbits + 57)/17;
+  static constexpr size_t nbatches = (ndivsteps + 29)/30;
+
+  static constexpr auto P30 = []() {
+    std::array<uint64_t, ndigits> ret{};
+    for (size_t d = 0; d < ndigits; ++d) {
+      const size_t bit = d*30;
+      const size_t l = bit/64;
+      const size_t off = bit%64;
+      if (l >= p.size()) {
+        continue;
+      }
+      uint64_t v = p[l] >> off;
+      if (off > 34 && (l+1) < p.size()) {
+        v |= p[l+1] << (64-off);
+      }
+      ret[d] = v & s30_mask;
+    }
+    return ret;
+  }();
+
+  // p**-1 % 2**30
+  static constexpr uint64_t pinv = []() {
+    uint64_t inv = p[0];
+    for (size_t i = 0; i < 6; ++i) {
+      inv *= 2 - p[0]*inv;
+    }
+    return inv & s30_mask;
+  }();
+};
+
+template <class WL>
+struct safegcd_trans {
+  WL u, v, q, r;
+};
+
+template <size_t N, concepts::wide_bignum WBN>
+static auto s30_from_wbn(WBN const& n)
+{
+  using WL = eve::wide<uint64_t, eve::cardinal_t<WBN>>;
+  constexpr auto nlimbs = bn_nlimbs<WBN>;
+  const WL mask{s30_mask};
+
+  std::array<WL, N> ret;
+  eve::detail::for_<0,1,N>([&](auto d_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto d = decltype(d_)::value;
+    constexpr auto l = (d*30)/64;
+    constexpr auto off = (d*30)%64;
+    if constexpr (l < nlimbs) {
+      WL v = eve::get<l>(n) >> off;
+      if constexpr (off > 34 && (l+1) < nlimbs) {
+        v |= eve::get<l+1>(n) << (64-off);
+      }
+      ret[d] = v & mask;
+    }
+    else {
+      ret[d] = eve::zero(eve::as<WL>());
+    }
+  });
+  return ret;
+}
+
+// Digits must be in [0, 2**30)
+template <concepts::wide_bignum WBN, class WL, size_t N>
+static auto s30_to_wbn(std::array<WL, N> const& v)
+{
+  constexpr auto nlimbs = bn_nlimbs<WBN>;
+
+  WBN ret;
+  eve::detail::for_<0,1,nlimbs>([&](auto l_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto l = decltype(l_)::value;
+    constexpr auto dbegin = (l*64)/30;
+    constexpr auto dend = std::min<size_t>((l*64+63)/30 + 1, N);
+    auto limb = eve::zero(eve::as<WL>());
+    eve::detail::for_<dbegin,1,dend>([&](auto d_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto d = decltype(d_)::value;
+      constexpr auto bit = d*30;
+      if constexpr (bit >= l*64) {
+        limb |= v[d] << (bit - l*64);
+      }
+      else {
+        limb |= v[d] >> (l*64 - bit);
+      }
+    });
+    eve::get<l>(ret) = limb;
+  });
+  return ret;
+}
+
+// Runs 30 divsteps on the lowest bits of f and g, and returns the new delta.
+// The transition matrix t is scaled by 2**30, that is
+// [f', g'] * 2**30 = t * [f, g].
+template <class WL>
+static auto safegcd_divsteps_30(WL delta, WL f, WL g, safegcd_trans<WL>& t)
+{
+  const WL zero = eve::zero(eve::as<WL>());
+  const WL one{1};
+  WL u = WL{1}, v = zero, q = zero, r = WL{1};
+
+  for (size_t i = 0; i < 30; ++i) {
+    // c1: delta > 0, c2: g is odd
+    const auto c1 = wide_uasr(zero - delta, 63);
+    const auto c2 = zero - (g & one);
+    const auto c = c1 & c2;
+
+    // If c, (f,g) = (g, g-f), else g = g + (g&1)*f
+    const auto x = (f ^ c) - c;
+    const auto y = (u ^ c) - c;
+    const auto z = (v ^ c) - c;
+    g += x & c2;
+    q += y & c2;
+    r += z & c2;
+    f += g & c;
+    u += q & c;
+    v += r & c;
+
+    // If c, delta = 1-delta, else delta = 1+delta
+    delta = (delta ^ c) - c + one;
+
+    g = wide_uasr(g, 1);
+    u <<= 1;
+    v <<= 1;
+  }
+  t = {u, v, q, r};
+  return delta;
+}
+
+// [f, g] = t * [f, g] / 2**30
+template <class WL, size_t N>
+static void safegcd_update_fg(std::array<WL, N>& f, std::array<WL, N>& g, safegcd_trans<WL> const& t)
+{
+  const WL mask{s30_mask};
+
+  WL cf = mullow_signed(t.u, f[0]) + mullow_signed(t.v, g[0]);
+  WL cg = mullow_signed(t.q, f[0]) + mullow_signed(t.r, g[0]);
+  cf = wide_uasr(cf, 30);
+  cg = wide_uasr(cg, 30);
+  eve::detail::for_<1,1,N>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    cf += mullow_signed(t.u, f[i]) + mullow_signed(t.v, g[i]);
+    cg += mullow_signed(t.q, f[i]) + mullow_signed(t.r, g[i]);
+    f[i-1] = cf & mask;
+    g[i-1] = cg & mask;
+    cf = wide_uasr(cf, 30);
+    cg = wide_uasr(cg, 30);
+  });
+  f[N-1] = cf;
+  g[N-1] = cg;
+}
+
+// [d, e] = (t * [d, e] + p * [md, me]) / 2**30, with md and me chosen so that
+// the division is exact. d and e stay in (-2p, p).
+template <concepts::bignum_cst P, class WL, size_t N>
+static void safegcd_update_de(std::array<WL, N>& d, std::array<WL, N>& e, safegcd_trans<WL> const& t)
+{
+  using csts = safegcd_constants<P>;
+  const WL mask{s30_mask};
+  const WL pinv{csts::pinv};
+
+  // md and me start with u,q if d < 0, plus v,r if e < 0
+  const auto sd = wide_uasr(d[N-1], 63);
+  const auto se = wide_uasr(e[N-1], 63);
+  auto md = (t.u & sd) + (t.v & se);
+  auto me = (t.q & sd) + (t.r & se);
+
+  WL cd = mullow_signed(t.u, d[0]) + mullow_signed(t.v, e[0]);
+  WL ce = mullow_signed(t.q, d[0]) + mullow_signed(t.r, e[0]);
+
+  md -= (mullow(pinv, cd) + md) & mask;
+  me -= (mullow(pinv, ce) + me) & mask;
+
+  cd += mullow_signed(WL{csts::P30[0]}, md);
+  ce += mullow_signed(WL{csts::P30[0]}, me);
+  cd = wide_uasr(cd, 30);
+  ce = wide_uasr(ce, 30);
+
+  eve::detail::for_<1,1,N>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    const WL pi{csts::P30[i]};
+    cd += mullow_signed(t.u, d[i]) + mullow_signed(t.v, e[i]) + mullow_signed(pi, md);
+    ce += mullow_signed(t.q, d[i]) + mullow_signed(t.r, e[i]) + mullow_signed(pi, me);
+    d[i-1] = cd & mask;
+    e[i-1] = ce & mask;
+    cd = wide_uasr(cd, 30);
+    ce = wide_uasr(ce, 30);
+  });
+  d[N-1] = cd;
+  e[N-1] = ce;
+}
+
+// Brings r from (-2p, p) to [0, p), negating it if sign is negative
+template <concepts::bignum_cst P, class WL, size_t N>
+static void safegcd_normalize(std::array<WL, N>& r, WL const& sign)
+{
+  using csts = safegcd_constants<P>;
+  const WL mask{s30_mask};
+
+  auto propagate = [&]() EVE_LAMBDA_FORCEINLINE {
+    eve::detail::for_<1,1,N>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto i = decltype(i_)::value;
+      r[i] += wide_uasr(r[i-1], 30);
+      r[i-1] &= mask;
+    });
+  };
+
+  auto cond_add = wide_uasr(r[N-1], 63);
+  const auto cond_negate = wide_uasr(sign, 63);
+  eve::detail::for_<0,1,N>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    r[i] += WL{csts::P30[i]} & cond_add;
+    r[i] = (r[i] ^ cond_negate) - cond_negate;
+  });
+  propagate();
+
+  cond_add = wide_uasr(r[N-1], 63);
+  eve::detail::for_<0,1,N>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    r[i] += WL{csts::P30[i]} & cond_add;
+  });
+  propagate();
+}
+
+} // details
+
+// Returns x**-1 % p (and 0 if x == 0), for x in [0, p). Runs in constant time.
+template <concepts::bignum_cst P, concepts::wide_bignum WBN>
+WBN safegcd_inverse(WBN const& x)
+{
+  using csts = details::safegcd_constants<P>;
+  using WL = eve::wide<uint64_t, eve::cardinal_t<WBN>>;
+  constexpr auto N = csts::ndigits;
+  const WL zero = eve::zero(eve::as<WL>());
+
+  std::array<WL, N> d, e, f;
+  auto g = details::s30_from_wbn<N>(x);
+  for (size_t i = 0; i < N; ++i) {
+    d[i] = zero;
+    e[i] = zero;
+    f[i] = WL{csts::P30[i]};
+  }
+  e[0] = WL{1};
+
+  WL delta{1};
+  details::safegcd_trans<WL> t;
+  for (size_t i = 0; i < csts::nbatches; ++i) {
+    delta = details::safegcd_divsteps_30(delta, f[0], g[0], t);
+    details::safegcd_update_de<P>(d, e, t);
+    details::safegcd_update_fg(f, g, t);
+  }
+
+  // f is now +/-1, and d = +/-x**-1
+  details::safegcd_normalize<P>(d, f[N-1]);
+  return details::s30_to_wbn<WBN>(d);
+}
+
+} // ecsimd
+
+#endif
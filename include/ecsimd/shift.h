@@ -13,7 +13,6 @@ namespace ecsimd {
 template <concepts::wide_bignum WBN>
 auto shift_left_one(WBN const& a) {
   using limb_type = bn_limb_t<WBN>;
-  constexpr auto limb_bits = std::numeric_limits<limb_type>::digits;
 
   cmp_res_t<WBN> carry;
   WBN ret;
@@ -25,7 +24,7 @@ auto shift_left_one(WBN const& a) {
     if constexpr (i > 0) {
       shifted |= carry.mask() & limb_type{1};
     }
-    carry = wide_uasr(l, limb_bits-1);
+    carry = wide_is_msb_set(l);
     eve::get<i>(ret) = shifted;
   });
   return std::make_tuple(ret, carry);
@@ -36,7 +35,7 @@ const auto pad(WBN const& v) {
   using limb_type = bn_limb_t<WBN>;
   constexpr auto v_nlimbs = bn_nlimbs<WBN>;
   constexpr auto ret_nlimbs = v_nlimbs+N;
-  using ret_ty = wide_bignum<bignum<limb_type, ret_nlimbs>>;
+  using ret_ty = wide_bignum<bignum<limb_type, ret_nlimbs>, eve::cardinal_t<WBN>>;
 
   ret_ty ret;
   eve::detail::for_<0,1,v_nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
@@ -55,7 +54,7 @@ auto limb_shift_left(WBN const& v)
 {
   using limb_type = bn_limb_t<WBN>;
   constexpr auto v_nlimbs = bn_nlimbs<WBN>;
-  using ret_ty = wide_bignum<bignum<limb_type, RetLimbs>>;
+  using ret_ty = wide_bignum<bignum<limb_type, RetLimbs>, eve::cardinal_t<WBN>>;
 
   if constexpr (ShiftBy >= RetLimbs || ShiftBy >= v_nlimbs) {
     return eve::zero(eve::as<ret_ty>());
@@ -84,7 +83,7 @@ auto limb_shift_right(WBN const& v)
   constexpr auto v_nlimbs = bn_nlimbs<WBN>;
   static_assert(ShiftBy < v_nlimbs);
   constexpr auto ret_limbs = v_nlimbs-ShiftBy;
-  using ret_ty = wide_bignum<bignum<limb_type, ret_limbs>>;
+  using ret_ty = wide_bignum<bignum<limb_type, ret_limbs>, eve::cardinal_t<WBN>>;
 
 
   ret_ty ret;
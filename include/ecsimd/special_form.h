@@ -0,0 +1,390 @@
+#ifndef ECSIMD_SPECIAL_FORM_H
+#define ECSIMD_SPECIAL_FORM_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/classical_form.h>
+#include <ecsimd/mgry.h>
+#include <ecsimd/mgry_csts.h>
+#include <ecsimd/mul.h>
+#include <ecsimd/modular.h>
+#include <ecsimd/utility.h>
+
+#include <ctbignum/division.hpp>
+#include <ctbignum/mult.hpp>
+#include <ctbignum/slicing.hpp>
+
+#include <eve/wide.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace ecsimd {
+
+// Reduction modulo primes of special form. Products are computed over 32-bit
+// digits (each stored in a 64-bit lane, see mul_u32_zext), and, with N the
+// number of bits of the modulus' bignum type, c = 2**N % p is used to fold the
+// high digits onto the low ones:
+// * generalized Mersenne primes (e.g. NIST P-256 and P-384): c has a signed
+//   base 2**32 representation with digits in {-1,0,1}. Every high digit is
+//   folded using a compile-time matrix of small coefficients, so that the
+//   reduction is only made of additions and subtractions.
+// * pseudo-Mersenne primes (e.g. secp256k1's p or 2**255-19): c is small, and
+//   high digits are multiplied by c.
+// Other primes use the Montgomery reduction (see mgry_mul.h).
+
+enum class reduction_kind {
+  montgomery,
+  generalized_mersenne,
+  pseudo_mersenne
+};
+
+template <concepts::bignum_cst P>
+struct special_form_constants {
+  using BN = bn_t<P>;
+  static_assert(std::is_same_v<bn_limb_t<BN>, uint64_t>);
+  static constexpr size_t nlimbs = bn_nlimbs<BN>;
+  static constexpr size_t ndigits = 2*nlimbs;
+
+  static constexpr auto p = P::value.cbn();
+  static constexpr auto c = cbn::div(cbn::detail::unary_encoding<nlimbs, nlimbs+1>(), p).remainder;
+
+  // Unsigned base 2**32 digits of c
+  static constexpr auto c_digits = []() {
+    std::array<uint64_t, ndigits> ret{};
+    for (size_t i = 0; i < nlimbs; ++i) {
+      ret[2*i]   = c[i] & 0xFFFFFFFF;
+      ret[2*i+1] = c[i] >> 32;
+    }
+    return ret;
+  }();
+
+  // Signed base 2**32 digits of c, in [-2**31, 2**31[
+  static constexpr auto c_signed = []() {
+    std::array<int64_t, ndigits+1> ret{};
+    int64_t carry = 0;
+    for (size_t i = 0; i < ndigits; ++i) {
+      int64_t d = int64_t(c_digits[i]) + carry;
+      carry = 0;
+      if (d >= (int64_t{1} << 31)) {
+        d -= int64_t{1} << 32;
+        carry = 1;
+      }
+      ret[i] = d;
+    }
+    ret[ndigits] = carry;
+    return ret;
+  }();
+
+  // c can be folded onto the low digits without producing new high digits
+  static constexpr bool has_sparse_c = []() {
+    if (c_signed[ndigits] != 0) {
+      return false;
+    }
+    for (auto d: c_signed) {
+      if (d < -1 || d > 1) {
+        return false;
+      }
+    }
+    return true;
+  }();
+
+  // Coefficients are kept below this bound, so that sums of 32-bit digits
+  // multiplied by them fit in 62 bits.
+  static constexpr int64_t max_coef = int64_t{1} << 24;
+
+  // 2**(32*(ndigits+k)) = sum(matrix[k][i]*2**(32*i)) [p]. Only computed if
+  // c is sparse.
+  static constexpr auto matrix_or_empty = []() {
+    std::array<std::array<int64_t, ndigits>, ndigits> ret{};
+    if (!has_sparse_c) {
+      return std::make_pair(ret, false);
+    }
+    for (size_t k = 0; k < ndigits; ++k) {
+      std::array<int64_t, 2*ndigits> v{};
+      v[ndigits+k] = 1;
+      for (size_t m = 2*ndigits-1; m >= ndigits; --m) {
+        const auto coef = v[m];
+        if (coef > max_coef || coef < -max_coef) {
+          return std::make_pair(ret, false);
+        }
+        v[m] = 0;
+        for (size_t j = 0; j < ndigits; ++j) {
+          v[m-ndigits+j] += coef*c_signed[j];
+        }
+      }
+      for (size_t i = 0; i < ndigits; ++i) {
+        ret[k][i] = v[i];
+      }
+    }
+    return std::make_pair(ret, true);
+  }();
+  static constexpr auto matrix = matrix_or_empty.first;
+
+  // 2**(2N) = sum(top_row[i]*2**(32*i)) [p], as 2**(2N) = c*2**N [p]. Only
+  // computed if c is sparse.
+  static constexpr auto top_row = []() {
+    std::array<int64_t, ndigits> ret{};
+    for (size_t j = 0; j < ndigits; ++j) {
+      for (size_t i = 0; i < ndigits; ++i) {
+        ret[i] += c_signed[j]*matrix[j][i];
+      }
+    }
+    return ret;
+  }();
+
+  // Upper bound of the absolute value of the carry out of the folded digits
+  static constexpr int64_t max_carry = []() {
+    int64_t ret = 1;
+    for (size_t i = 0; i < ndigits; ++i) {
+      int64_t pos = 1;
+      int64_t neg = 0;
+      for (size_t k = 0; k < ndigits; ++k) {
+        const auto m = matrix[k][i];
+        if (m > 0) {
+          pos += m;
+        }
+        else {
+          neg -= m;
+        }
+      }
+      ret = std::max(ret, std::max(pos, neg) + 1);
+    }
+    return ret;
+  }();
+
+  static constexpr bool is_generalized_mersenne = []() {
+    if (!matrix_or_empty.second || max_carry >= max_coef) {
+      return false;
+    }
+    // The carry must be folded twice: (max_carry+1)*c < 2**N
+    const auto cm = cbn::mul(c, cbn::big_int<1, uint64_t>{uint64_t(max_carry+1)});
+    return cm[nlimbs] == 0;
+  }();
+
+  // c0 + c1*2**32, with c0+c1 < 2**31
+  static constexpr bool is_pseudo_mersenne = []() {
+    for (size_t i = 2; i < ndigits; ++i) {
+      if (c_digits[i] != 0) {
+        return false;
+      }
+    }
+    return (c_digits[0] + c_digits[1]) < (uint64_t{1} << 31);
+  }();
+
+  static constexpr reduction_kind kind =
+    is_generalized_mersenne ? reduction_kind::generalized_mersenne :
+    (is_pseudo_mersenne ? reduction_kind::pseudo_mersenne : reduction_kind::montgomery);
+
+  // Number of conditional subtractions needed to reduce a value < 2**N
+  static constexpr size_t nsubs = []() {
+    typename BN::cbn_type all_ones{};
+    for (auto& v: all_ones) {
+      v = ~uint64_t{0};
+    }
+    return size_t(cbn::div(all_ones, p).quotient[0]);
+  }();
+};
+
+namespace details {
+
+// acc += M*v, with v < 2**32
+template <int64_t M, class WL>
+static void sf_madd(WL& acc, WL const& v) {
+  constexpr uint64_t absM = M < 0 ? uint64_t(-M) : uint64_t(M);
+  if constexpr (M == 0) {
+    return;
+  }
+  else if constexpr (std::popcount(absM) <= 2) {
+    constexpr auto s0 = std::countr_zero(absM);
+    constexpr auto s1 = std::bit_width(absM) - 1;
+    auto t = v << s0;
+    if constexpr (s1 != s0) {
+      t += v << s1;
+    }
+    if constexpr (M > 0) {
+      acc += t;
+    }
+    else {
+      acc -= t;
+    }
+  }
+  else {
+    const auto t = mullow(v, WL{absM});
+    if constexpr (M > 0) {
+      acc += t;
+    }
+    else {
+      acc -= t;
+    }
+  }
+}
+
+// Folds the signed carry d (of weight 2**N) onto v
+template <concepts::bignum_cst P, concepts::wide_bignum WD, class WL>
+static void sf_fold_carry_signed(WD& v, WL const& d)
+{
+  using csts = special_form_constants<P>;
+  eve::detail::for_<0,1,csts::ndigits>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto j = decltype(j_)::value;
+    constexpr auto cj = csts::c_signed[j];
+    static_assert(cj >= -1 && cj <= 1);
+    if constexpr (cj == 1) {
+      eve::get<j>(v) += d;
+    }
+    else if constexpr (cj == -1) {
+      eve::get<j>(v) -= d;
+    }
+  });
+}
+
+// Folds the unsigned carry d (of weight 2**N) onto v
+template <concepts::bignum_cst P, concepts::wide_bignum WD, class WL>
+static void sf_fold_carry_unsigned(WD& v, WL const& d)
+{
+  using csts = special_form_constants<P>;
+  constexpr auto c0 = int64_t(csts::c_digits[0]);
+  constexpr auto c1 = int64_t(csts::c_digits[1]);
+  const WL mask{0xFFFFFFFF};
+  const auto dlo = d & mask;
+  const auto dhi = d >> 32;
+  sf_madd<c0>(eve::get<0>(v), dlo);
+  sf_madd<c1>(eve::get<1>(v), dlo);
+  sf_madd<c0>(eve::get<1>(v), dhi);
+  sf_madd<c1>(eve::get<2>(v), dhi);
+}
+
+// The optional top is a digit of weight 2**(2N), lower than 2**32 (see
+// sf_reduce).
+template <concepts::bignum_cst P, concepts::wide_bignum WD, class... Top>
+static auto generalized_mersenne_fold(WD const& t, Top const&... top)
+{
+  using csts = special_form_constants<P>;
+  using cardinal = eve::cardinal_t<WD>;
+  constexpr auto ndigits = csts::ndigits;
+  using ret_type = eve::wide<bignum<uint64_t, ndigits>, cardinal>;
+
+  ret_type v;
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    auto s = eve::get<i>(t);
+    eve::detail::for_<0,1,ndigits>([&](auto k_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto k = decltype(k_)::value;
+      sf_madd<csts::matrix[k][i]>(s, eve::get<ndigits+k>(t));
+    });
+    (sf_madd<csts::top_row[i]>(s, top), ...);
+    eve::get<i>(v) = s;
+  });
+
+  // The first carry is bounded by max_carry (plus one with a small top), the
+  // second one is in {-1,0,1}, and the last one is zero.
+  sf_fold_carry_signed<P>(v, propagate_u32_zext<true>(v));
+  sf_fold_carry_signed<P>(v, propagate_u32_zext<true>(v));
+  propagate_u32_zext<true>(v);
+  return v;
+}
+
+template <concepts::bignum_cst P, concepts::wide_bignum WD, class... Top>
+static auto pseudo_mersenne_fold(WD const& t, Top const&... top)
+{
+  using csts = special_form_constants<P>;
+  using cardinal = eve::cardinal_t<WD>;
+  using WL = eve::wide<uint64_t, cardinal>;
+  constexpr auto ndigits = csts::ndigits;
+  constexpr auto c0 = int64_t(csts::c_digits[0]);
+  constexpr auto c1 = int64_t(csts::c_digits[1]);
+  using ret_type = eve::wide<bignum<uint64_t, ndigits>, cardinal>;
+
+  // t_low + t_high*c
+  ret_type v;
+  WL carry = eve::zero(eve::as<WL>());
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    auto s = eve::get<i>(t);
+    sf_madd<c0>(s, eve::get<ndigits+i>(t));
+    if constexpr (i > 0) {
+      sf_madd<c1>(s, eve::get<ndigits+i-1>(t));
+    }
+    eve::get<i>(v) = s;
+  });
+  sf_madd<c1>(carry, eve::get<2*ndigits-1>(t));
+  if constexpr (sizeof...(Top) > 0) {
+    // top*2**(2N) = top*c*2**N [p]
+    WL carry_hi = eve::zero(eve::as<WL>());
+    (sf_madd<c0>(carry, top), ...);
+    (sf_madd<c1>(carry_hi, top), ...);
+    carry += carry_hi << 32;
+  }
+
+  sf_fold_carry_unsigned<P>(v, carry + propagate_u32_zext<false>(v));
+  sf_fold_carry_unsigned<P>(v, propagate_u32_zext<false>(v));
+  propagate_u32_zext<false>(v);
+  return v;
+}
+
+// Reduces t (2*ndigits 32-bit digits, as returned by mul_u32_zext) modulo P.
+// An optional top digit of weight 2**(2N), lower than 2**32, can be given for
+// sums larger than 2**(2N) (see sum_of_products.h).
+template <concepts::bignum_cst P, concepts::wide_bignum WD, class... Top>
+static auto sf_reduce(WD const& t, Top const&... top)
+{
+  static_assert(sizeof...(Top) <= 1);
+  using csts = special_form_constants<P>;
+  using cardinal = eve::cardinal_t<WD>;
+  using WBN = eve::wide<bn_t<P>, cardinal>;
+  static_assert(bn_nlimbs<WD> == 2*csts::ndigits);
+
+  WBN ret;
+  if constexpr (csts::kind == reduction_kind::generalized_mersenne) {
+    ret = trunc_u64x32(generalized_mersenne_fold<P>(t, top...));
+  }
+  else {
+    static_assert(csts::kind == reduction_kind::pseudo_mersenne);
+    ret = trunc_u64x32(pseudo_mersenne_fold<P>(t, top...));
+  }
+
+  const auto& wide_P = mgry_constants<WBN, P>::wide_P;
+#pragma unroll
+  for (size_t i = 0; i < csts::nsubs; ++i) {
+    ret = sub_if_above(ret, wide_P);
+  }
+  return ret;
+}
+
+} // details
+
+// Field elements stored in classical form (see classical_form.h), reduced
+// with the special form of P
+struct special_form_reduction
+{
+  template <concepts::bignum_cst P>
+  static constexpr bool supports = special_form_constants<P>::kind != reduction_kind::montgomery;
+
+  template <concepts::bignum_cst P, concepts::wide_bignum WD>
+  static auto reduce(WD const& t) {
+    return details::sf_reduce<P>(t);
+  }
+};
+
+template <concepts::wide_bignum WBN, concepts::bignum_cst P>
+using wide_special_bignum = wide_classical_bignum<WBN, P, special_form_reduction>;
+
+namespace concepts {
+template <class T>
+concept wide_special_bignum = wide_classical_bignum<T> &&
+  std::same_as<typename T::reduction_type, special_form_reduction>;
+} // concepts
+
+// Selects the fastest representation for P
+template <concepts::wide_bignum WBN, concepts::bignum_cst P>
+using wide_field_bignum = std::conditional_t<
+  special_form_constants<P>::kind == reduction_kind::montgomery,
+  wide_mgry_bignum<WBN, P>,
+  wide_special_bignum<WBN, P>>;
+
+} // ecsimd
+
+#endif
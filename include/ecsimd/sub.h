@@ -2,15 +2,18 @@
 #define FPSIMD_BIGINT_SUB_H
 
 #include <eve/wide.hpp>
+#include <ecsimd/add.h>
 #include <ecsimd/bignum.h>
 
+#include <array>
 #include <tuple>
 #include <iostream>
 
 namespace ecsimd {
 
+// Borrows ripple through the limbs, one after the other
 template <concepts::wide_bignum WBN>
-auto sub(WBN const& a, WBN const& b)
+auto sub_ripple(WBN const& a, WBN const& b)
 {
   using limb_type = bn_limb_t<WBN>;
   using C = typename WBN::cardinal_type;
@@ -37,6 +40,45 @@ auto sub(WBN const& a, WBN const& b)
   return std::make_tuple(ret, carry_mask);
 }
 
+// Same as add_lookahead: a limb generates a borrow if b > a, and propagates
+// it if a == b.
+template <concepts::wide_bignum WBN>
+auto sub_lookahead(WBN const& a, WBN const& b)
+{
+  constexpr auto nlimbs = bn_nlimbs<WBN>;
+
+  WBN diff;
+  std::array<cmp_res_t<WBN>, nlimbs> g, p;
+  eve::detail::for_<0, 1, nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    const auto aa = eve::get<i>(a);
+    const auto bb = eve::get<i>(b);
+    eve::get<i>(diff) = aa - bb;
+    g[i] = bb > aa;
+    p[i] = bb == aa;
+  });
+  details::carry_lookahead(g, p);
+
+  WBN ret;
+  eve::get<0>(ret) = eve::get<0>(diff);
+  eve::detail::for_<1, 1, nlimbs>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    eve::get<i>(ret) = eve::get<i>(diff) + g[i-1].mask();
+  });
+  return std::make_tuple(ret, g[nlimbs-1]);
+}
+
+template <concepts::wide_bignum WBN>
+auto sub(WBN const& a, WBN const& b)
+{
+  if constexpr (use_carry_lookahead<WBN>) {
+    return sub_lookahead(a, b);
+  }
+  else {
+    return sub_ripple(a, b);
+  }
+}
+
 template <concepts::wide_bignum WBN>
 auto sub_no_carry(WBN const& a, WBN const& b) {
   return std::get<0>(sub(a,b));
@@ -0,0 +1,341 @@
+#ifndef ECSIMD_SUM_OF_PRODUCTS_H
+#define ECSIMD_SUM_OF_PRODUCTS_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mgry.h>
+#include <ecsimd/mgry_csts.h>
+#include <ecsimd/mgry_mul.h>
+#include <ecsimd/mgry_ops.h>
+#include <ecsimd/mul.h>
+#include <ecsimd/special_form.h>
+
+#include <ctbignum/addition.hpp>
+#include <ctbignum/mult.hpp>
+#include <ctbignum/relational_ops.hpp>
+#include <ctbignum/slicing.hpp>
+
+#include <eve/wide.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace ecsimd {
+
+// Sums of signed products and offsets, like a*b - c*d - e, computed with a
+// single reduction. Terms are built with mul_term, sqr_term and add_term
+// (and negated with the unary minus), e.g.:
+//
+//   mgry_sum_of_products(mul_term(a, b), -mul_term(c, d), -add_term(e))
+//
+// Products are accumulated as 2N-bit numbers over 32-bit digits (see
+// mul_u32_zext), offsets being added with a weight of R. Each negative term
+// is compensated by adding p*2**N, so that the accumulator of K terms stays
+// in [0, K*p*2**N[. It is then reduced once:
+// * wide_mgry_bignum: by the Montgomery reduction, whose result (lower than
+//   (K+1)*p) is brought below p like in mgry_mul_small;
+// * wide_special_bignum: by folding the high digits (see special_form.h).
+// Other representations (and primes for which these bounds do not hold)
+// chain their own multiplications, additions and subtractions.
+
+enum class sop_kind {
+  mul,
+  sqr,
+  offset
+};
+
+struct sop_none { };
+
+// Sign*a*b, Sign*a**2 or Sign*a
+template <sop_kind Kind, bool Neg, class A, class B = sop_none>
+struct sop_term {
+  using a_type = A;
+  using b_type = B;
+  static constexpr sop_kind kind = Kind;
+  static constexpr bool neg = Neg;
+
+  A a;
+  B b;
+};
+
+namespace concepts {
+template <class T>
+concept sop_term = std::same_as<T, ecsimd::sop_term<T::kind, T::neg, typename T::a_type, typename T::b_type>>;
+} // concepts
+
+template <class A, class B>
+sop_term<sop_kind::mul, false, A, B> mul_term(A const& a, B const& b) {
+  return {a, b};
+}
+
+template <class A>
+sop_term<sop_kind::sqr, false, A> sqr_term(A const& a) {
+  return {a, {}};
+}
+
+template <class A>
+sop_term<sop_kind::offset, false, A> add_term(A const& a) {
+  return {a, {}};
+}
+
+template <sop_kind Kind, bool Neg, class A, class B>
+sop_term<Kind, !Neg, A, B> operator-(sop_term<Kind, Neg, A, B> const& t) {
+  return {t.a, t.b};
+}
+
+namespace details {
+
+// Applies f to the operands of t
+template <concepts::sop_term T, class F>
+auto sop_transform(T const& t, F const& f) {
+  if constexpr (T::kind == sop_kind::mul) {
+    return sop_term<T::kind, T::neg, decltype(f(t.a)), decltype(f(t.b))>{f(t.a), f(t.b)};
+  }
+  else {
+    return sop_term<T::kind, T::neg, decltype(f(t.a))>{f(t.a), {}};
+  }
+}
+
+// Operations of the chained evaluation, on representations or on GFp-like
+// types
+template <class A, class B>
+auto sop_mul(A const& a, B const& b) {
+  if constexpr (concepts::mgry_repr<A>) {
+    return mgry_mul(a, b);
+  }
+  else {
+    return a * b;
+  }
+}
+
+template <class A>
+auto sop_sqr(A const& a) {
+  if constexpr (concepts::mgry_repr<A>) {
+    return mgry_sqr(a);
+  }
+  else {
+    return a.sqr();
+  }
+}
+
+template <class A, class B>
+auto sop_add(A const& a, B const& b) {
+  if constexpr (concepts::mgry_repr<A>) {
+    return mgry_add(a, b);
+  }
+  else {
+    return a + b;
+  }
+}
+
+template <class A, class B>
+auto sop_sub(A const& a, B const& b) {
+  if constexpr (concepts::mgry_repr<A>) {
+    return mgry_sub(a, b);
+  }
+  else {
+    return a - b;
+  }
+}
+
+// Value of t, without its sign
+template <concepts::sop_term T>
+auto sop_abs(T const& t) {
+  if constexpr (T::kind == sop_kind::mul) {
+    return sop_mul(t.a, t.b);
+  }
+  else if constexpr (T::kind == sop_kind::sqr) {
+    return sop_sqr(t.a);
+  }
+  else {
+    return t.a;
+  }
+}
+
+template <class Acc>
+auto sop_fold(Acc const& acc) {
+  return acc;
+}
+
+template <class Acc, concepts::sop_term T, concepts::sop_term... Ts>
+auto sop_fold(Acc const& acc, T const& t, Ts const&... ts) {
+  if constexpr (T::neg) {
+    return sop_fold(sop_sub(acc, sop_abs(t)), ts...);
+  }
+  else {
+    return sop_fold(sop_add(acc, sop_abs(t)), ts...);
+  }
+}
+
+// Terms are evaluated and summed one after the other
+template <concepts::sop_term T0, concepts::sop_term... Ts>
+auto sop_chain(T0 const& t0, Ts const&... ts) {
+  static_assert(!T0::neg, "the first term must be positive");
+  return sop_fold(sop_abs(t0), ts...);
+}
+
+template <concepts::bignum_cst P, size_t K>
+struct sop_constants {
+  using BN = bn_t<P>;
+  static_assert(std::is_same_v<bn_limb_t<BN>, uint64_t>);
+  static constexpr size_t nlimbs = bn_nlimbs<BN>;
+  static constexpr size_t ndigits = 2*nlimbs;
+
+  static constexpr auto p = P::value.cbn();
+  static constexpr auto two_n = cbn::detail::unary_encoding<nlimbs, nlimbs+1>();
+  // 2**N - p
+  static constexpr auto c = cbn::subtract_ignore_carry(two_n, cbn::detail::pad<1>(p));
+
+  // The Montgomery reduction r of the sum is lower than (K+1)*p, and
+  // r - (r >> N)*p is lower than 2**N + K*c, which must be lower than 2p.
+  static constexpr bool mgry_single_correction =
+    cbn::short_mul(c, uint64_t{K+2}) < cbn::short_mul(two_n, uint64_t{1});
+
+  // The high digits of the sum are lower than (K+1)*2**32 (instead of 2**32
+  // for a single product), which multiplies the bounds of the carries of
+  // the folds (see special_form_constants). The carry out of the sum adds at
+  // most one to them.
+  static constexpr bool sf_foldable = []() {
+    using sf = special_form_constants<P>;
+    if constexpr (sf::kind == reduction_kind::generalized_mersenne) {
+      constexpr auto carry = int64_t(K+1)*sf::max_carry + 1;
+      const auto cm = cbn::mul(sf::c, cbn::big_int<1, uint64_t>{uint64_t(carry+1)});
+      return (2*carry+1) < (int64_t{1} << 30) && cm[nlimbs] == 0;
+    }
+    else if constexpr (sf::kind == reduction_kind::pseudo_mersenne) {
+      return (K+1)*(1 + sf::c_digits[0] + sf::c_digits[1]) < (uint64_t{1} << 31);
+    }
+    else {
+      return false;
+    }
+  }();
+};
+
+// Sum of the terms as 2n zero-extended 32-bit digits lower than 2**32, and
+// the carry out of the last one. Offsets are added at digit Offset.
+template <concepts::bignum_cst P, size_t Offset, concepts::sop_term... Ts>
+static auto sop_accumulate(Ts const&... ts)
+{
+  constexpr size_t K = sizeof...(Ts);
+  constexpr size_t nneg = (size_t(Ts::neg) + ...);
+  using csts = sop_constants<P, K>;
+  constexpr auto ndigits = csts::ndigits;
+
+  using WMBN = typename std::tuple_element_t<0, std::tuple<Ts...>>::a_type;
+  using cardinal = eve::cardinal_t<typename WMBN::wide_bignum_type>;
+  using WL = eve::wide<uint64_t, cardinal>;
+  using WT = eve::wide<bignum<uint64_t, 2*ndigits>, cardinal>;
+
+  auto acc = eve::zero(eve::as<WT>());
+  auto accumulate = [&](auto const& t) EVE_LAMBDA_FORCEINLINE {
+    using T = std::decay_t<decltype(t)>;
+    auto add_digits = [&](auto const& v, auto offset_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto offset = decltype(offset_)::value;
+      eve::detail::for_<0,1,bn_nlimbs<std::decay_t<decltype(v)>>>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+        constexpr auto i = decltype(i_)::value;
+        if constexpr (T::neg) {
+          eve::get<offset+i>(acc) -= eve::get<i>(v);
+        }
+        else {
+          eve::get<offset+i>(acc) += eve::get<i>(v);
+        }
+      });
+    };
+    const auto az = zext_u32x64(t.a.wbn());
+    if constexpr (T::kind == sop_kind::mul) {
+      add_digits(mul_u32_zext(az, zext_u32x64(t.b.wbn())), std::integral_constant<size_t, 0>{});
+    }
+    else if constexpr (T::kind == sop_kind::sqr) {
+      add_digits(square_u32_zext(az), std::integral_constant<size_t, 0>{});
+    }
+    else {
+      add_digits(az, std::integral_constant<size_t, Offset>{});
+    }
+  };
+  (accumulate(ts), ...);
+
+  // Every negative term is greater than -p*2**N
+  if constexpr (nneg > 0) {
+    eve::detail::for_<0,1,ndigits>([&](auto j_) EVE_LAMBDA_FORCEINLINE {
+      constexpr auto j = decltype(j_)::value;
+      constexpr auto pd = nneg*mgry_cst_p<P, cardinal>::digits[j];
+      if constexpr (pd != 0) {
+        eve::get<ndigits+j>(acc) += WL{pd};
+      }
+    });
+  }
+  const auto top = propagate_u32_zext<true>(acc);
+  return std::make_pair(acc, top);
+}
+
+template <concepts::sop_term... Ts>
+static auto mgry_sop_reduce(Ts const&... ts)
+{
+  using WMBN = typename std::tuple_element_t<0, std::tuple<Ts...>>::a_type;
+  using P = typename WMBN::P_type;
+  using cardinal = eve::cardinal_t<typename WMBN::wide_bignum_type>;
+  using WBN = eve::wide<bn_t<P>, cardinal>;
+  using WL = eve::wide<uint64_t, cardinal>;
+  using csts = sop_constants<P, sizeof...(Ts)>;
+  using cst_p = mgry_cst_p<P, cardinal>;
+  constexpr auto ndigits = csts::ndigits;
+
+  const auto [t, top] = sop_accumulate<P, ndigits>(ts...);
+  const auto r = mgry_reduce_u32_zext(t, top, cst_p{}, cst_p{});
+
+  // r - q*p, with q = r >> N. As c < p (see mgry_single_correction), c is
+  // also 2**N % p, whose digits are given by special_form_constants.
+  const WL q = eve::get<ndigits>(r);
+  wbn_zext_t<WBN> v;
+  eve::detail::for_<0,1,ndigits>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    auto d = eve::get<i>(r);
+    sf_madd<int64_t(special_form_constants<P>::c_digits[i])>(d, q);
+    eve::get<i>(v) = d;
+  });
+  const auto carry = propagate_u32_zext<false>(v);
+  return WMBN{trunc_u64x32(u32x64_sub_if_above(v, mgry_constants<WBN, P>::wide_P_zext, carry))};
+}
+
+template <concepts::sop_term... Ts>
+static auto sf_sop_reduce(Ts const&... ts)
+{
+  using WMBN = typename std::tuple_element_t<0, std::tuple<Ts...>>::a_type;
+  using P = typename WMBN::P_type;
+
+  // The carry out of the sum is folded as a digit of weight 2**(2N), so that
+  // the high digits stay lower than 2**32.
+  const auto [t, top] = sop_accumulate<P, 0>(ts...);
+  return WMBN{sf_reduce<P>(t, top)};
+}
+
+} // details
+
+// Sum of the terms [p], with a single reduction when possible. All the
+// operands are of the same representation WMBN, and the first term must be
+// positive.
+template <concepts::sop_term T0, concepts::sop_term... Ts>
+  requires concepts::mgry_repr<typename T0::a_type>
+auto mgry_sum_of_products(T0 const& t0, Ts const&... ts) {
+  using WMBN = typename T0::a_type;
+  using P = typename WMBN::P_type;
+  using csts = details::sop_constants<P, 1+sizeof...(Ts)>;
+  static_assert(!T0::neg, "the first term must be positive");
+
+  if constexpr (concepts::wide_mgry_bignum<WMBN> && csts::mgry_single_correction) {
+    return details::mgry_sop_reduce(t0, ts...);
+  }
+  else if constexpr (concepts::wide_special_bignum<WMBN> && csts::sf_foldable) {
+    return details::sf_sop_reduce(t0, ts...);
+  }
+  else {
+    return WMBN{details::sop_chain(t0, ts...)};
+  }
+}
+
+} // ecsimd
+
+#endif
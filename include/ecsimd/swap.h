@@ -33,22 +33,24 @@ void swap_if(cmp_res_t<typename GFP::WBN> mask, GFP& a, GFP& b)
   swap_if(mask, a.wbn(), b.wbn());
 }
 
-template <concepts::curve Curve>
+template <concepts::curve Curve, class Cardinal,
+          template <class, class> class MgryRepr>
 void swap_if(
-    cmp_res_t<curve_wide_bn_t<Curve>> mask,
-    wide_jacobian_curve_point<Curve>& A,
-    wide_jacobian_curve_point<Curve>& B)
+    cmp_res_t<curve_wide_bn_t<Curve, Cardinal>> mask,
+    wide_jacobian_curve_point<Curve, Cardinal, MgryRepr>& A,
+    wide_jacobian_curve_point<Curve, Cardinal, MgryRepr>& B)
 {
   swap_if(mask, A.x(), B.x());
   swap_if(mask, A.y(), B.y());
   swap_if(mask, A.z(), B.z());
 }
 
-template <concepts::curve Curve>
+template <concepts::curve Curve, class Cardinal,
+          template <class, class> class MgryRepr>
 void swap_if_same_z(
-    cmp_res_t<curve_wide_bn_t<Curve>> mask,
-    wide_jacobian_curve_point<Curve>& A,
-    wide_jacobian_curve_point<Curve>& B)
+    cmp_res_t<curve_wide_bn_t<Curve, Cardinal>> mask,
+    wide_jacobian_curve_point<Curve, Cardinal, MgryRepr>& A,
+    wide_jacobian_curve_point<Curve, Cardinal, MgryRepr>& B)
 {
   assert(eve::all(A.z().wbn() == B.z().wbn()));
   swap_if(mask, A.x(), B.x());
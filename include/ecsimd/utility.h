@@ -41,13 +41,19 @@ static auto wide_uasr(eve::wide<T, C> uv, auto S) {
   return std::bit_cast<eve::wide<T,C>>(sv);
 }
 
+// Returns a mask with lanes set if the most significant bit of v is set
+template <std::unsigned_integral T, class C>
+static auto wide_is_msb_set(eve::wide<T, C> v) {
+  using Signed = eve::detail::make_integer_t<sizeof(T), signed>;
+  using SW = eve::wide<Signed, C>;
+  const auto ret = std::bit_cast<SW>(v) < eve::zero(eve::as<SW>());
+  return std::bit_cast<eve::logical<eve::wide<T, C>>>(ret);
+}
+
 template <std::unsigned_integral T, class C>
 static auto wide_mask_bit(eve::wide<T, C> v, auto B) {
-  using wide_ty = eve::wide<T,C>;
   constexpr auto nbits = std::numeric_limits<T>::digits;
-
-  const auto wlsb = wide_ty{1};
-  return eve::logical<wide_ty>{wide_uasr(v << (nbits-B-1), nbits-1)};
+  return wide_is_msb_set(v << (nbits-B-1));
 }
 
 } // ecsimd
@@ -0,0 +1,252 @@
+#ifndef ECSIMD_WIDE_DIGITS_H
+#define ECSIMD_WIDE_DIGITS_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mgry_context.h>
+#include <ecsimd/mgry_ops.h>
+#include <ecsimd/mul.h>
+
+#include <eve/wide.hpp>
+#include <eve/function/all.hpp>
+#include <eve/function/if_else.hpp>
+
+#include <ctbignum/division.hpp>
+
+#include <array>
+#include <cassert>
+#include <limits>
+
+namespace ecsimd {
+
+// Numbers of NDigits 32-bit digits zero-extended to 64 bits, with one vector
+// per digit (the u32x64 form of mgry_mul.h). Digits are indexed at runtime,
+// so that the kernels below are loops: the fully unrolled kernels of
+// mgry_mul.h do not scale to RSA sizes (a 2048-bit mgry_mul is ~650KB of
+// code).
+template <size_t NDigits, class Cardinal = default_cardinal>
+using wide_digits = std::array<eve::wide<uint64_t, Cardinal>, NDigits>;
+
+namespace details {
+
+static constexpr size_t digit_bits = 32;
+static constexpr uint64_t digit_mask = std::numeric_limits<uint32_t>::max();
+
+template <class C>
+static auto digits_low_mask() {
+  return eve::wide<uint64_t, C>{digit_mask};
+}
+
+} // details
+
+template <concepts::wide_bignum WBN>
+auto to_digits(WBN const& n) {
+  static_assert(std::is_same_v<bn_limb_t<WBN>, uint64_t>);
+  using C = eve::cardinal_t<WBN>;
+  using WL = eve::wide<uint64_t, C>;
+  const WL mask{details::digit_mask};
+  wide_digits<2*bn_nlimbs<WBN>, C> ret;
+  eve::detail::for_<0,1,bn_nlimbs<WBN>>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    ret[2*i] = eve::get<i>(n) & mask;
+    ret[2*i+1] = eve::get<i>(n) >> details::digit_bits;
+  });
+  return ret;
+}
+
+// The digits of d must be lower than 2**32
+template <concepts::wide_bignum WBN, size_t NDigits, class C>
+WBN from_digits(wide_digits<NDigits, C> const& d) {
+  static_assert(NDigits == 2*bn_nlimbs<WBN>);
+  WBN ret;
+  eve::detail::for_<0,1,bn_nlimbs<WBN>>([&](auto i_) EVE_LAMBDA_FORCEINLINE {
+    constexpr auto i = decltype(i_)::value;
+    eve::get<i>(ret) = d[2*i] | (d[2*i+1] << details::digit_bits);
+  });
+  return ret;
+}
+
+// For each lane, a if mask else b
+template <size_t N, class C, class Mask>
+wide_digits<N, C> digits_select(Mask const& mask, wide_digits<N, C> const& a, wide_digits<N, C> const& b) {
+  wide_digits<N, C> ret;
+  for (size_t i = 0; i < N; ++i) {
+    ret[i] = eve::if_else(mask, a[i], b[i]);
+  }
+  return ret;
+}
+
+// a+b, with the carry as an extra digit
+template <size_t N, class C>
+wide_digits<N+1, C> digits_add(wide_digits<N, C> const& a, wide_digits<N, C> const& b) {
+  const auto mask = details::digits_low_mask<C>();
+  wide_digits<N+1, C> ret;
+  eve::wide<uint64_t, C> carry{0};
+  for (size_t i = 0; i < N; ++i) {
+    const auto s = a[i] + b[i] + carry;
+    ret[i] = s & mask;
+    carry = s >> details::digit_bits;
+  }
+  ret[N] = carry;
+  return ret;
+}
+
+// a-b, and the mask of the lanes for which a < b
+template <size_t N, class C>
+auto digits_sub(wide_digits<N, C> const& a, wide_digits<N, C> const& b) {
+  const auto mask = details::digits_low_mask<C>();
+  wide_digits<N, C> ret;
+  eve::wide<uint64_t, C> borrow{0};
+  for (size_t i = 0; i < N; ++i) {
+    const auto d = a[i] - b[i] - borrow;
+    ret[i] = d & mask;
+    borrow = d >> 63;
+  }
+  return std::make_pair(ret, borrow != 0);
+}
+
+// a*b, schoolbook
+template <size_t N, size_t M, class C>
+wide_digits<N+M, C> digits_mul(wide_digits<N, C> const& a, wide_digits<M, C> const& b) {
+  const auto mask = details::digits_low_mask<C>();
+  wide_digits<N+M, C> t;
+  t.fill(eve::wide<uint64_t, C>{0});
+  for (size_t i = 0; i < M; ++i) {
+    eve::wide<uint64_t, C> carry{0};
+    for (size_t j = 0; j < N; ++j) {
+      const auto u = t[i+j] + mullow(a[j], b[i]) + carry;
+      t[i+j] = u & mask;
+      carry = u >> details::digit_bits;
+    }
+    t[i+N] = carry;
+  }
+  return t;
+}
+
+// Montgomery arithmetic over wide_digits, modulo a runtime modulus (that can
+// be different in each lane). This is the same as mgry_context, for large
+// numbers. R is 2**(32*NDigits).
+template <size_t NDigits, class Cardinal = default_cardinal>
+class mgry_digits_context {
+public:
+  using WL = eve::wide<uint64_t, Cardinal>;
+  using digits_type = wide_digits<NDigits, Cardinal>;
+
+  // Every lane of p must be odd
+  template <concepts::wide_bignum WBN>
+  explicit mgry_digits_context(WBN const& p):
+    P_(to_digits(p))
+  {
+    static_assert(2*bn_nlimbs<WBN> == NDigits);
+    assert(eve::all((P_[0] & WL{1}) == WL{1}));
+
+    mprime_ = details::runtime_mprime(P_[0]);
+    R_p_ = to_digits(details::runtime_R_pow_mod<1>(p));
+    Rsq_p_ = to_digits(details::runtime_R_pow_mod<2>(p));
+  }
+
+  digits_type const& P() const { return P_; }
+  digits_type const& R() const { return R_p_; }
+  digits_type const& Rsq() const { return Rsq_p_; }
+
+  // n*R [p], for n < R
+  digits_type from_classical(digits_type const& n) const {
+    return mul(n, Rsq_p_);
+  }
+
+  digits_type to_classical(digits_type const& n) const {
+    digits_type one;
+    one.fill(WL{0});
+    one[0] = WL{1};
+    return mul(n, one);
+  }
+
+  // a*b*R**-1 [p] (CIOS, see details::mgry_mul_u32_zext), for a*b < p*R
+  digits_type mul(digits_type const& a, digits_type const& b) const {
+    const auto mask = details::digits_low_mask<Cardinal>();
+    wide_digits<NDigits+2, Cardinal> t;
+    t.fill(WL{0});
+    for (size_t i = 0; i < NDigits; ++i) {
+      const auto bi = b[i];
+      auto u = t[0] + mullow(a[0], bi);
+      auto c0 = u >> details::digit_bits;
+      const auto m = mullow(u, mprime_);
+      auto v = (u & mask) + mullow(m, P_[0]);
+      auto c1 = v >> details::digit_bits;
+      for (size_t j = 1; j < NDigits; ++j) {
+        u = t[j] + mullow(a[j], bi) + c0;
+        c0 = u >> details::digit_bits;
+        v = (u & mask) + mullow(m, P_[j]) + c1;
+        c1 = v >> details::digit_bits;
+        t[j-1] = v & mask;
+      }
+      u = t[NDigits] + c0 + c1;
+      t[NDigits-1] = u & mask;
+      t[NDigits] = u >> details::digit_bits;
+    }
+    return reduce_once(t);
+  }
+
+  digits_type sqr(digits_type const& a) const {
+    return mul(a, a);
+  }
+
+  digits_type add(digits_type const& a, digits_type const& b) const {
+    const auto s = digits_add(a, b);
+    wide_digits<NDigits+2, Cardinal> t;
+    std::copy(s.begin(), s.end(), t.begin());
+    t[NDigits+1] = WL{0};
+    return reduce_once(t);
+  }
+
+  digits_type sub(digits_type const& a, digits_type const& b) const {
+    const auto [d, borrow] = digits_sub(a, b);
+    const auto dp = digits_add(d, P_);
+    digits_type dpt;
+    std::copy(dp.begin(), dp.begin()+NDigits, dpt.begin());
+    return digits_select(borrow, dpt, d);
+  }
+
+  // a**M*R [p], M public (see mgry_pow_window)
+  template <size_t W = 4, concepts::bignum BE>
+  digits_type pow(digits_type const& a, BE const& M) const {
+    return details::pow_sliding_window<W>(R_p_, a, M,
+      [this](digits_type const& x, digits_type const& y) { return mul(x, y); },
+      [this](digits_type const& x) { return sqr(x); });
+  }
+
+  // a**M[i]*R [p] in lane i, in constant time (see mgry_pow_window)
+  template <size_t W = 4, concepts::wide_bignum WE>
+  digits_type pow(digits_type const& a, WE const& M) const {
+    static_assert(std::is_same_v<eve::cardinal_t<WE>, Cardinal>);
+    return details::pow_fixed_window<W>(R_p_, a, M,
+      [this](digits_type const& x, digits_type const& y) { return mul(x, y); },
+      [this](digits_type const& x) { return sqr(x); },
+      [](auto const& mask, digits_type const& x, digits_type const& y) { return digits_select(mask, x, y); });
+  }
+
+private:
+  // t - p if t >= p, for t < 2p with NDigits+2 digits
+  digits_type reduce_once(wide_digits<NDigits+2, Cardinal> const& t) const {
+    const auto mask = details::digits_low_mask<Cardinal>();
+    digits_type ret;
+    digits_type tsub;
+    WL borrow{0};
+    for (size_t i = 0; i < NDigits; ++i) {
+      const auto d = t[i] - P_[i] - borrow;
+      tsub[i] = d & mask;
+      borrow = d >> 63;
+      ret[i] = t[i];
+    }
+    borrow = (t[NDigits] - borrow) >> 63;
+    return digits_select(borrow != 0, ret, tsub);
+  }
+
+  digits_type P_;
+  WL mprime_;
+  digits_type R_p_;
+  digits_type Rsq_p_;
+};
+
+} // ecsimd
+
+#endif
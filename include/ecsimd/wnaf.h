@@ -0,0 +1,46 @@
+#ifndef ECSIMD_WNAF_H
+#define ECSIMD_WNAF_H
+
+#include <ecsimd/bignum.h>
+#include <ecsimd/mgry_ops.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace ecsimd {
+
+// Width-W non-adjacent form of k: k = sum(d[i]*2**i), where every non-zero
+// digit is odd, in ]-2**(W-1), 2**(W-1)[, and followed by at least W-1 zero
+// digits. A number of N bits has at most N+1 digits. The recoding (and its
+// use) is not constant time, and must only be used with public scalars.
+template <size_t W, concepts::bignum BN>
+auto bn_wnaf(BN const& k) {
+  static_assert(W >= 2 && W <= 8);
+  using limb_type = bn_limb_t<BN>;
+  constexpr size_t nbits = bn_nlimbs<BN>*std::numeric_limits<limb_type>::digits;
+
+  const auto window = [&](size_t bit) -> int {
+    return bit < nbits ? int(details::bn_window<W>(k, bit)) : 0;
+  };
+
+  std::array<int8_t, nbits+1> ret{};
+  int carry = 0;
+  size_t bit = 0;
+  while (bit <= nbits) {
+    if ((window(bit) & 1) == carry) {
+      ++bit;
+      continue;
+    }
+    int word = window(bit) + carry;
+    carry = (word >> (W-1)) & 1;
+    word -= carry << W;
+    ret[bit] = int8_t(word);
+    bit += W;
+  }
+  return ret;
+}
+
+} // ecsimd
+
+#endif
@@ -10,3 +10,11 @@ using WJCP = wide_jacobian_curve_point<Curve>;
 auto scalar_mult_p256(WBN const& x, WJCP const& P) {
   return curve_group<Curve>::scalar_mult(x, P);
 }
+
+auto scalar_mult_base_p256(WBN const& x) {
+  return curve_group<Curve>::scalar_mult_base(x);
+}
+
+auto scalar_mult_vartime_p256(WBN const& x, WJCP const& P) {
+  return curve_group<Curve>::scalar_mult_vartime(x, P);
+}
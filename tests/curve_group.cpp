@@ -2,6 +2,9 @@
 #include <ecsimd/jacobian_curve_point.h>
 #include <ecsimd/curve_group.h>
 #include <ecsimd/curve_nist_p256.h>
+#include <ecsimd/mgry_r52.h>
+#include <ecsimd/mgry_r29.h>
+#include <ecsimd/mgry_u32x64.h>
 #include <ecsimd/serialization.h>
 #include <ecsimd/swap.h>
 #include <ecsimd/literals.h>
@@ -171,3 +174,152 @@ TEST(CurveGroup, ScalarMult) {
     EXPECT_TRUE(eve::all(WPs.y() == WP_y));
   }
 }
+
+template <class Cardinal,
+          template <class, class> class MgryRepr = wide_field_bignum>
+static void TestScalarMultCardinal() {
+  using Curve = curve_nist_p256;
+  using CurveGroup = curve_group<Curve, Cardinal, MgryRepr>;
+  using WBN = curve_wide_bn_t<Curve, Cardinal>;
+  using BN = typename WBN::value_type;
+
+  const auto WJG = CurveGroup::WJG();
+  const auto xs = bn_from_bytes_BE<BN>("0a891cecc2bf13b0aca744434a9c9f4bd7bf5c8ed86e2f76e7df72bad813bd80"_hex);
+  const auto WP = CurveGroup::scalar_mult(WBN{xs}, WJG).to_affine();
+  const auto WPs = CurveGroup::scalar_mult_1s(xs, WJG).to_affine();
+
+  const auto WP_x = wide_bignum_set1<WBN>("f411d79e2997b2954975046d23b0e4a69ce580a4a81e1bed18fef6fd9ea4a912"_hex);
+  const auto WP_y = wide_bignum_set1<WBN>("43895f527937e816c3d7c0a2370002796d3cd4860cb034df86cbe7da227d9113"_hex);
+  EXPECT_TRUE(eve::all(WP.x() == WP_x));
+  EXPECT_TRUE(eve::all(WP.y() == WP_y));
+  EXPECT_TRUE(eve::all(WPs.x() == WP_x));
+  EXPECT_TRUE(eve::all(WPs.y() == WP_y));
+}
+
+TEST(CurveGroup, ScalarMultCardinal) {
+  TestScalarMultCardinal<eve::fixed<2>>();
+  TestScalarMultCardinal<eve::fixed<8>>();
+}
+
+TEST(CurveGroup, ScalarMultMgry) {
+  TestScalarMultCardinal<eve::fixed<4>, wide_mgry_bignum>();
+}
+
+TEST(CurveGroup, ScalarMultU32x64) {
+  TestScalarMultCardinal<eve::fixed<4>, wide_mgry_u32x64>();
+}
+
+TEST(CurveGroup, ScalarMultR29) {
+  TestScalarMultCardinal<eve::fixed<4>, wide_mgry_r29>();
+}
+
+TEST(CurveGroup, ScalarMultR52) {
+  TestScalarMultCardinal<eve::fixed<4>, wide_mgry_r52>();
+}
+
+template <class Cardinal,
+          template <class, class> class MgryRepr = wide_field_bignum>
+static void TestScalarMultBase() {
+  using Curve = curve_nist_p256;
+  using CurveGroup = curve_group<Curve, Cardinal, MgryRepr>;
+  using WBN = curve_wide_bn_t<Curve, Cardinal>;
+  using BN = typename WBN::value_type;
+  constexpr auto card = Cardinal::value;
+
+  // Small, even, odd and close to n scalars, compared to the ladder
+  const std::array<BN, 7> xs = {
+    bn_from_bytes_BE<BN>("0000000000000000000000000000000000000000000000000000000000000001"_hex),
+    bn_from_bytes_BE<BN>("0000000000000000000000000000000000000000000000000000000000000002"_hex),
+    bn_from_bytes_BE<BN>("0000000000000000000000000000000000000000000000000000000000000005"_hex),
+    bn_from_bytes_BE<BN>("0bc1b1f28709decb543d9677d2cc9942348f6b984deff409430740942ff38827"_hex),
+    bn_from_bytes_BE<BN>("0a891cecc2bf13b0aca744434a9c9f4bd7bf5c8ed86e2f76e7df72bad813bd80"_hex),
+    bn_from_bytes_BE<BN>("e0c17da8904a727d8ae1bf36bf8a79260d012f00d4d80888d1d0bb44fda16da4"_hex),
+    bn_from_bytes_BE<BN>("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc63254f"_hex),
+  };
+
+  const auto WJG = CurveGroup::WJG();
+  for (size_t i = 0; i < xs.size(); i += card) {
+    const auto x = WBN{[&](auto l, auto) { return xs[(i+l) % xs.size()]; }};
+    const auto WP = CurveGroup::scalar_mult_base(x).to_affine();
+    const auto WPref = CurveGroup::scalar_mult(x, WJG).to_affine();
+    EXPECT_TRUE(eve::all(WP.x() == WPref.x()));
+    EXPECT_TRUE(eve::all(WP.y() == WPref.y()));
+  }
+
+  // (n-1)*G = -G, which is an exceptional case of the ladder
+  const auto WPm1 = CurveGroup::scalar_mult_base(wide_bignum_set1<WBN>("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632550"_hex)).to_affine();
+  const auto WmG = CurveGroup::WJG().opposite().to_affine();
+  EXPECT_TRUE(eve::all(WPm1.x() == WmG.x()));
+  EXPECT_TRUE(eve::all(WPm1.y() == WmG.y()));
+
+  const auto xs5 = bn_from_bytes_BE<BN>("0000000000000000000000000000000000000000000000000000000000000005"_hex);
+  const auto WP = CurveGroup::scalar_mult_base(WBN{xs5}).to_affine();
+  EXPECT_TRUE(eve::all(WP.x() == wide_bignum_set1<WBN>("51590b7a515140d2d784c85608668fdfef8c82fd1f5be52421554a0dc3d033ed"_hex)));
+  EXPECT_TRUE(eve::all(WP.y() == wide_bignum_set1<WBN>("e0c17da8904a727d8ae1bf36bf8a79260d012f00d4d80888d1d0bb44fda16da4"_hex)));
+}
+
+TEST(CurveGroup, ScalarMultBase) {
+  TestScalarMultBase<eve::fixed<2>>();
+  TestScalarMultBase<eve::fixed<4>>();
+  TestScalarMultBase<eve::fixed<8>>();
+  TestScalarMultBase<eve::fixed<4>, wide_mgry_bignum>();
+  TestScalarMultBase<eve::fixed<4>, wide_mgry_u32x64>();
+  TestScalarMultBase<eve::fixed<4>, wide_mgry_r29>();
+  TestScalarMultBase<eve::fixed<4>, wide_mgry_r52>();
+}
+
+TEST(CurveGroup, DBL) {
+  using Curve = curve_nist_p256;
+  using CurveGroup = curve_group<Curve>;
+
+  // Doubling a point with Z != 1
+  auto WJG = CurveGroup::WJG();
+  const auto WJ2G = CurveGroup::DBLU(WJG);
+  const auto WP = CurveGroup::DBL(WJ2G).to_affine();
+  const auto WPref = CurveGroup::ADD_Z2_1(CurveGroup::ZADDU(WJG, WJ2G), CurveGroup::WJG()).to_affine();
+  EXPECT_TRUE(eve::all(WP.x() == WPref.x()));
+  EXPECT_TRUE(eve::all(WP.y() == WPref.y()));
+}
+
+template <class Cardinal,
+          template <class, class> class MgryRepr = wide_field_bignum>
+static void TestScalarMultVartime() {
+  using Curve = curve_nist_p256;
+  using CurveGroup = curve_group<Curve, Cardinal, MgryRepr>;
+  using WBN = curve_wide_bn_t<Curve, Cardinal>;
+  using BN = typename WBN::value_type;
+  constexpr auto card = Cardinal::value;
+
+  const std::array<BN, 7> xs = {
+    bn_from_bytes_BE<BN>("0000000000000000000000000000000000000000000000000000000000000001"_hex),
+    bn_from_bytes_BE<BN>("0bc1b1f28709decb543d9677d2cc9942348f6b984deff409430740942ff38827"_hex),
+    bn_from_bytes_BE<BN>("0000000000000000000000000000000000000000000000000000000000000002"_hex),
+    bn_from_bytes_BE<BN>("0a891cecc2bf13b0aca744434a9c9f4bd7bf5c8ed86e2f76e7df72bad813bd80"_hex),
+    bn_from_bytes_BE<BN>("0000000000000000000000000000000000000000000000000000000000000005"_hex),
+    bn_from_bytes_BE<BN>("e0c17da8904a727d8ae1bf36bf8a79260d012f00d4d80888d1d0bb44fda16da4"_hex),
+    bn_from_bytes_BE<BN>("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc63254f"_hex),
+  };
+
+  // G, and 5*G
+  auto WJG = CurveGroup::WJG();
+  const auto WJ5G = CurveGroup::WJCP::from_affine(CurveGroup::scalar_mult(WBN{xs[4]}, WJG).to_affine());
+  for (auto const& WJP: {WJG, WJ5G}) {
+    for (size_t i = 0; i < xs.size(); i += card) {
+      const auto x = WBN{[&](auto l, auto) { return xs[(i+l) % xs.size()]; }};
+      const auto WP = CurveGroup::scalar_mult_vartime(x, WJP).to_affine();
+      const auto WPref = CurveGroup::scalar_mult(x, WJP).to_affine();
+      EXPECT_TRUE(eve::all(WP.x() == WPref.x()));
+      EXPECT_TRUE(eve::all(WP.y() == WPref.y()));
+    }
+  }
+}
+
+TEST(CurveGroup, ScalarMultVartime) {
+  TestScalarMultVartime<eve::fixed<2>>();
+  TestScalarMultVartime<eve::fixed<4>>();
+  TestScalarMultVartime<eve::fixed<8>>();
+  TestScalarMultVartime<eve::fixed<4>, wide_mgry_bignum>();
+  TestScalarMultVartime<eve::fixed<4>, wide_mgry_u32x64>();
+  TestScalarMultVartime<eve::fixed<4>, wide_mgry_r29>();
+  TestScalarMultVartime<eve::fixed<4>, wide_mgry_r52>();
+}
@@ -9,6 +9,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "tests.h"
 
 using namespace ecsimd;
@@ -40,3 +42,51 @@ TEST(JacobianCurvePoint, ToFromAffine) {
 
   EXPECT_TRUE(eve::all(*opt == apt));
 }
+
+TEST(JacobianCurvePoint, BatchToAffine) {
+  using Curve = curve_nist_p256;
+  using WideCurvePoint = wide_curve_point<curve_nist_p256>;
+  using WideJacobianCurvePoint = wide_jacobian_curve_point<curve_nist_p256>;
+  using WBN = curve_wide_bn_t<Curve>;
+  using gfp = WideJacobianCurvePoint::gfp;
+
+  const auto x = wide_bignum_set1<WBN>("ce11d601ec0e947529e66021a0cd3d57518d58d0d5f2eb7ed75805d78c986e60"_hex);
+  const auto opt = WideCurvePoint::from_x(x);
+  EXPECT_TRUE(opt.has_value());
+
+  // Same affine point, with different Z coordinates. The lane 1 of the last
+  // point is at infinity.
+  std::vector<WideJacobianCurvePoint> jpts;
+  auto z = gfp::from_classical(wide_bignum_set1<WBN>("2714dac0b974321b75d6ef64e7c3b118adb2801bf674282df5712cd2af390f79"_hex));
+  for (size_t i = 0; i < 5; ++i) {
+    auto jpt = WideJacobianCurvePoint::from_affine(*opt);
+    const auto z2 = z.sqr();
+    jpt.x() = jpt.x() * z2;
+    jpt.y() = jpt.y() * z2 * z;
+    jpt.z() = z;
+    jpts.push_back(jpt);
+    z = z.sqr() + gfp::one();
+  }
+  using WL = eve::wide<uint64_t, eve::cardinal_t<WBN>>;
+  const auto lane1 = WL{[](auto i, auto) { return uint64_t(i); }} == WL{1};
+  jpts.back().z() = if_else(lane1, gfp::from_classical(eve::zero(eve::as<WBN>())), gfp::one());
+
+  std::vector<WideCurvePoint> apts(jpts.size());
+  WideJacobianCurvePoint::batch_to_affine(jpts, apts);
+  for (size_t i = 0; i < jpts.size(); ++i) {
+    EXPECT_TRUE(eve::all(apts[i] == jpts[i].to_affine()));
+  }
+  for (size_t i = 0; i+1 < jpts.size(); ++i) {
+    EXPECT_TRUE(eve::all(apts[i] == *opt));
+  }
+  EXPECT_EQ(apts.back().x().get(1), bignum_256{});
+  EXPECT_EQ(apts.back().y().get(1), bignum_256{});
+
+  auto npts = jpts;
+  WideJacobianCurvePoint::batch_normalize(npts);
+  for (size_t i = 0; i+1 < npts.size(); ++i) {
+    EXPECT_TRUE(eve::all(npts[i].z().wbn() == gfp::one().wbn()));
+    EXPECT_TRUE(eve::all(npts[i].to_affine() == *opt));
+  }
+  EXPECT_EQ(npts.back().z().wbn().get(1), bignum_256{});
+}
@@ -1,19 +1,34 @@
 #include <ecsimd/mgry.h>
 #include <ecsimd/mgry_mul.h>
 #include <ecsimd/mgry_ops.h>
+#include <ecsimd/mgry_context.h>
+#include <ecsimd/ifma.h>
+#include <ecsimd/mgry_r52.h>
+#include <ecsimd/mgry_r29.h>
+#include <ecsimd/mgry_u32x64.h>
+#include <ecsimd/gfp_lazy.h>
+#include <ecsimd/special_form.h>
+#include <ecsimd/barrett.h>
+#include <ecsimd/mul_small.h>
 #include <ecsimd/gfp.h>
+#include <ecsimd/gfn.h>
+#include <ecsimd/curve_nist_p256.h>
 #include <ecsimd/serialization.h>
 #include <ecsimd/literals.h>
 
 #include <ctbignum/decimal_literals.hpp>
 #include <ctbignum/montgomery.hpp>
+#include <ctbignum/mod_inv.hpp>
 #include <ctbignum/io.hpp>
 #include <ctbignum/relational_ops.hpp>
 
 #include <eve/function/all.hpp>
+#include <eve/function/any.hpp>
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "tests.h"
 
 using namespace ecsimd;
@@ -119,10 +134,11 @@ TEST(Mgry, Ops) {
   }
 }
 
-TEST(Mgry, Gfp) {
-  using WBN = wide_bignum<bignum_256>;
-  using WMBN = wide_mgry_bignum<WBN, P>;
-  using GFP = GFp<WBN, P>;
+// Inverse, square root and opposite in GF(P), with P = 2**256 - 2**32 - 977
+template <class GFP>
+static void TestGfpKnownAnswers()
+{
+  using WBN = typename GFP::WBN;
 
   {
     const auto a = wide_bignum_set1<WBN>("FFFFFFFFFFFFFFFFFFFFFF000000000000000000000000000000000000000004"_hex);
@@ -148,3 +164,756 @@ TEST(Mgry, Gfp) {
     EXPECT_TRUE(eve::all(Z.wbn() == eve::zero(eve::as(Z.wbn()))));
   }
 }
+
+TEST(Mgry, Gfp) {
+  using WBN = wide_bignum<bignum_256>;
+  using WMBN = wide_mgry_bignum<WBN, P>;
+  TestGfpKnownAnswers<GFp<WBN, P, WMBN>>();
+}
+
+template <concepts::bignum_cst Pr, template <class, class> class MgryRepr>
+static void TestGfpRepr()
+{
+  using BN = bn_t<Pr>;
+  using WBN = eve::wide<BN, eve::fixed<8>>;
+  using GFP = GFp<WBN, Pr, MgryRepr<WBN, Pr>>;
+  constexpr auto p = Pr::value.cbn();
+
+  std::mt19937_64 rnd{0x52};
+
+  for (size_t n = 0; n < 16; ++n) {
+    const WBN a{[&](auto i, auto _) { return random_fe<Pr>(rnd); }};
+    const WBN b{[&](auto i, auto _) { return random_fe<Pr>(rnd); }};
+    const auto ga = GFP::from_classical(a);
+    const auto gb = GFP::from_classical(b);
+
+    EXPECT_TRUE(eve::all(ga.to_classical() == a));
+
+    const auto mul = (ga*gb).to_classical();
+    const auto sqr = ga.sqr().to_classical();
+    const auto add = (ga+gb).to_classical();
+    const auto sub = (ga-gb).to_classical();
+    const auto shl = gfp_shift_left<3>(ga).to_classical();
+    for (size_t i = 0; i < WBN::size(); ++i) {
+      const auto ac = a.get(i).cbn();
+      const auto bc = b.get(i).cbn();
+      EXPECT_EQ(mul.get(i).cbn(), cbn::div(cbn::mul(ac, bc), p).remainder);
+      EXPECT_EQ(sqr.get(i).cbn(), cbn::div(cbn::mul(ac, ac), p).remainder);
+      EXPECT_EQ(add.get(i).cbn(), cbn::mod_add(ac, bc, p));
+      EXPECT_EQ(sub.get(i).cbn(), cbn::mod_sub(ac, bc, p));
+      EXPECT_EQ(shl.get(i).cbn(), cbn::div(cbn::mul(ac, typename BN::cbn_type{8}), p).remainder);
+    }
+
+    EXPECT_TRUE(eve::all((ga*ga.inverse()).wbn() == GFP::one().wbn()));
+    EXPECT_TRUE(eve::all((ga+ga.opposite()).wbn() == eve::zero(eve::as(ga.wbn()))));
+  }
+}
+
+TEST(MgryR52, Gfp) {
+  TestGfpRepr<P, wide_mgry_r52>();
+  TestGfpRepr<curve_nist_p256::P, wide_mgry_r52>();
+
+  using WBN = eve::wide<bignum_256, eve::fixed<8>>;
+  using GFP = GFp<WBN, P, wide_mgry_r52<WBN, P>>;
+  {
+    const auto a = wide_bignum_set1<WBN>("FFFFFFFFFFFFFFFFFFFFFF000000000000000000000000000000000000000004"_hex);
+    const auto inv = GFP::from_classical(a).inverse().to_classical();
+    EXPECT_TRUE(eve::all(inv == wide_bignum_set1<WBN>("DC1B98237FD316F9AEE7342E6DC7629A75A99A9E9EF591170282CE3E1D8E26ED"_hex)));
+  }
+  {
+    const auto a = wide_bignum_set1<WBN>("b560fd7b259468b53c3a1623f35786a491fcb1fcdfbb0165da4dccce1f185b60"_hex);
+    const auto osqrt = GFP::from_classical(a).sqrt();
+    EXPECT_TRUE(osqrt.has_value());
+    EXPECT_TRUE(eve::all(osqrt->to_classical() == wide_bignum_set1<WBN>("a59f1be7c1f892ff2adf14187e9cff7666112af579bc1a11b63e248098567e71"_hex)));
+  }
+}
+
+// The emulation of the IFMA primitives is checked directly, as TestGfpRepr
+// only uses it on targets without AVX-512 IFMA (see also the mgry_ifma_emu
+// test target, which builds this file with ECSIMD_IFMA_EMULATION).
+TEST(Ifma, Mul52Emulation) {
+  using W = eve::wide<uint64_t, eve::fixed<8>>;
+  constexpr uint64_t m52 = (uint64_t{1} << 52) - 1;
+  constexpr uint64_t extremes[] = {0, 1, (uint64_t{1} << 26) - 1, uint64_t{1} << 26,
+    (uint64_t{1} << 51), m52, ~uint64_t{0}};
+
+  std::mt19937_64 rnd{0x1f3a};
+  const auto value = [&]() -> uint64_t {
+    const auto r = rnd() % (std::size(extremes)+1);
+    return r < std::size(extremes) ? extremes[r] : rnd();
+  };
+
+  for (size_t it = 0; it < 10000; ++it) {
+    const W a{[&](auto, auto) { return value(); }};
+    const W b{[&](auto, auto) { return value(); }};
+    const W acc{[&](auto, auto) { return rnd() & m52; }};
+
+    const auto [lo, hi] = details::mul52_emu(a, b);
+    const auto mlo = madd52lo(acc, a, b);
+    const auto mhi = madd52hi(acc, a, b);
+    for (size_t i = 0; i < W::size(); ++i) {
+      const auto prod = (unsigned __int128)(a.get(i) & m52) * (b.get(i) & m52);
+      EXPECT_EQ(lo.get(i), uint64_t(prod) & m52);
+      EXPECT_EQ(hi.get(i), uint64_t(prod >> 52));
+      // Native if available, emulated otherwise
+      EXPECT_EQ(mlo.get(i), acc.get(i) + (uint64_t(prod) & m52));
+      EXPECT_EQ(mhi.get(i), acc.get(i) + uint64_t(prod >> 52));
+    }
+  }
+}
+
+TEST(MgryR29, Gfp) {
+  TestGfpRepr<P, wide_mgry_r29>();
+  TestGfpRepr<curve_nist_p256::P, wide_mgry_r29>();
+}
+
+TEST(MgryU32x64, Gfp) {
+  TestGfpRepr<P, wide_mgry_u32x64>();
+  TestGfpRepr<curve_nist_p256::P, wide_mgry_u32x64>();
+}
+
+template <size_t N, class T, class U>
+static auto lazy_sum(T const& acc, U const& v)
+{
+  if constexpr (N == 0) {
+    return acc;
+  }
+  else {
+    return lazy_sum<N-1>(acc + v, v);
+  }
+}
+
+template <class GFP>
+static void TestGfpLazy()
+{
+  using WBN = typename GFP::WBN;
+
+  std::mt19937_64 rnd{0x1a2};
+
+  for (size_t n = 0; n < 16; ++n) {
+    const auto ga = GFP::from_classical(WBN{[&](auto i, auto _) { return random_fe<typename GFP::P_type>(rnd); }});
+    const auto gb = GFP::from_classical(WBN{[&](auto i, auto _) { return random_fe<typename GFP::P_type>(rnd); }});
+    const auto la = lazy(ga);
+    const auto lb = lazy(gb);
+
+    const GFP ref = ((ga-gb).sqr()*ga - gfp_shift_left<2>(gb+ga)) * (ga*gb - ga - gb - ga);
+    const GFP res = ((la-lb).sqr()*la - gfp_shift_left<2>(lb+la)) * (la*lb - la - lb - la);
+    EXPECT_TRUE(eve::all(res.wbn() == ref.wbn()));
+
+    // Accumulate values until the bound goes beyond what the representation
+    // can store.
+    auto ref_acc = ga*gb;
+    for (size_t i = 0; i < 20; ++i) {
+      ref_acc = ref_acc + ga*gb;
+    }
+    const auto res_acc = lazy_sum<20>(la*lb, la*lb);
+    EXPECT_TRUE(eve::all(res_acc == lazy(ref_acc)));
+  }
+}
+
+TEST(GFpLazy, Ops) {
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  using Pr = curve_nist_p256::P;
+  TestGfpLazy<GFp<WBN, Pr>>();
+  TestGfpLazy<GFp<WBN, Pr, wide_mgry_r52<WBN, Pr>>>();
+  TestGfpLazy<GFp<WBN, P, wide_mgry_r52<WBN, P>>>();
+  TestGfpLazy<GFp<WBN, Pr, wide_mgry_r29<WBN, Pr>>>();
+  TestGfpLazy<GFp<WBN, P, wide_mgry_r29<WBN, P>>>();
+}
+
+namespace {
+struct P384 {
+  static constexpr auto value = bn_from_bytes_BE<bignum<uint64_t, 6>>("fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffeffffffff0000000000000000ffffffff"_hex);
+};
+
+struct P25519 {
+  static constexpr auto value = bn_from_bytes_BE<bignum_256>("7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed"_hex);
+};
+
+// Not of special form
+struct PGeneric {
+  static constexpr auto value = bn_from_bytes_BE<bignum_256>("b560fd7b259468b53c3a1623f35786a491fcb1fcdfbb0165da4dccce1f185b61"_hex);
+};
+} // anonymous
+
+template <concepts::bignum_cst Pr>
+static void TestSpecialForm()
+{
+  using WBN = eve::wide<bn_t<Pr>, eve::fixed<4>>;
+  using WMBN = wide_special_bignum<WBN, Pr>;
+  check_fe_op<Pr, WBN, 2>([](auto const& v) { return mgry_mul(WMBN{v[0]}, WMBN{v[1]}).wbn(); },
+    [](auto const& c) { return mul_mod_ref<Pr>(c[0], c[1]); }, 128);
+  check_fe_op<Pr, WBN, 1>([](auto const& v) { return mgry_sqr(WMBN{v[0]}).wbn(); },
+    [](auto const& c) { return mul_mod_ref<Pr>(c[0], c[0]); }, 128);
+}
+
+TEST(SpecialForm, Kind) {
+  EXPECT_EQ(special_form_constants<curve_nist_p256::P>::kind, reduction_kind::generalized_mersenne);
+  EXPECT_EQ(special_form_constants<P384>::kind, reduction_kind::generalized_mersenne);
+  EXPECT_EQ(special_form_constants<P>::kind, reduction_kind::pseudo_mersenne);
+  EXPECT_EQ(special_form_constants<P25519>::kind, reduction_kind::pseudo_mersenne);
+  EXPECT_EQ(special_form_constants<P25519>::nsubs, 2);
+
+  EXPECT_EQ(special_form_constants<PGeneric>::kind, reduction_kind::montgomery);
+}
+
+TEST(SpecialForm, MulSqr) {
+  TestSpecialForm<curve_nist_p256::P>();
+  TestSpecialForm<P384>();
+  TestSpecialForm<P>();
+  TestSpecialForm<P25519>();
+}
+
+// P-256 products whose folded sum (see special_form_constants::matrix) has
+// the largest carries out of 2**256, 4 and -4, and (p-1)**2
+TEST(SpecialForm, P256Carry) {
+  using Pr = curve_nist_p256::P;
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  using WMBN = wide_special_bignum<WBN, Pr>;
+  {
+    const WMBN a{wide_bignum_set1<WBN>("fcfdf1f4ffffffff8000000000000000ffffffff000000000000000180000000"_hex)};
+    const auto r = wide_bignum_set1<WBN>("a206989df0e5b613b5eb754e7af1347585fb0fb5c807cd38ce0be9513f0aaf79"_hex);
+    EXPECT_TRUE(eve::all(mgry_mul(a, a).wbn() == r));
+    EXPECT_TRUE(eve::all(mgry_sqr(a).wbn() == r));
+  }
+  {
+    const WMBN a{wide_bignum_set1<WBN>("00000001ffffffffffffffff7fad71bd0000000100000000000000017fffffff"_hex)};
+    const WMBN b{wide_bignum_set1<WBN>("000000007fffffff701567b3ffffffff800000005a7da7ffabbdbe437fffffff"_hex)};
+    EXPECT_TRUE(eve::all(mgry_mul(a, b).wbn() == wide_bignum_set1<WBN>("b238eb45505bf13b7e9c957d1c0ee22cf7d20d48af196389446e7b7c2febf6fb"_hex)));
+  }
+  {
+    const WMBN a{wide_bignum_set1<WBN>("ffffffff00000001000000000000000000000000fffffffffffffffffffffffe"_hex)};
+    const auto one = wide_bignum_set1<WBN>("0000000000000000000000000000000000000000000000000000000000000001"_hex);
+    EXPECT_TRUE(eve::all(mgry_mul(a, a).wbn() == one));
+    EXPECT_TRUE(eve::all(mgry_sqr(a).wbn() == one));
+  }
+}
+
+TEST(SpecialForm, GfpPseudoMersenne) {
+  using WBN = wide_bignum<bignum_256>;
+  using GFP = GFp<WBN, P>;
+  static_assert(std::is_same_v<GFP::WMBN, wide_special_bignum<WBN, P>>);
+  TestGfpKnownAnswers<GFP>();
+}
+
+TEST(SpecialForm, Gfp) {
+  using Pr = curve_nist_p256::P;
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  using GFP = GFp<WBN, Pr, wide_field_bignum<WBN, Pr>>;
+  static_assert(std::is_same_v<GFP::WMBN, wide_special_bignum<WBN, Pr>>);
+  const auto a = GFP::from_classical(wide_bignum_set1<WBN>("b560fd7b259468b53c3a1623f35786a491fcb1fcdfbb0165da4dccce1f185b60"_hex));
+  EXPECT_TRUE(eve::all((a*a.inverse()).wbn() == GFP::one().wbn()));
+  EXPECT_TRUE(eve::all((a+a.opposite()).wbn() == eve::zero(eve::as(a.wbn()))));
+  const auto s = a.sqr().sqrt();
+  EXPECT_TRUE(s.has_value());
+  EXPECT_TRUE(eve::all(s->sqr().wbn() == a.sqr().wbn()));
+}
+
+template <concepts::bignum_cst Pr>
+static void TestBarrett()
+{
+  using WBN = eve::wide<bn_t<Pr>, eve::fixed<4>>;
+  using WD = wbn_zext_t<WBN>;
+  using WMBN = wide_barrett_bignum<WBN, Pr>;
+
+  // Numbers up to p*2**(bits of p), made of a high and a low element
+  check_fe_op<Pr, WBN, 2>([](auto const& v) {
+      const WD t{[&](auto i, auto _) { return WD::value_type::from(cbn::detail::join(v[1].get(i).cbn(), v[0].get(i).cbn())); }};
+      return barrett_reduce<Pr>(t);
+    },
+    [](auto const& c) { return cbn::div(cbn::detail::join(c[1], c[0]), Pr::value.cbn()).remainder; }, 128);
+  check_fe_op<Pr, WBN, 2>([](auto const& v) { return mgry_mul(WMBN{v[0]}, WMBN{v[1]}).wbn(); },
+    [](auto const& c) { return mul_mod_ref<Pr>(c[0], c[1]); }, 128);
+  check_fe_op<Pr, WBN, 1>([](auto const& v) { return mgry_sqr(WMBN{v[0]}).wbn(); },
+    [](auto const& c) { return mul_mod_ref<Pr>(c[0], c[0]); }, 128);
+}
+
+TEST(Barrett, Reduce) {
+  TestBarrett<curve_nist_p256::P>();
+  TestBarrett<curve_nist_p256::N>();
+  TestBarrett<P384>();
+  TestBarrett<P>();
+  TestBarrett<P25519>();
+  TestBarrett<PGeneric>();
+}
+
+TEST(Barrett, LargestP256) {
+  // 2**512-1, the largest input, whose quotient estimate is below the
+  // quotient
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  const auto t = wide_bignum_set1<wbn_zext_t<WBN>>(
+    "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"_hex);
+  EXPECT_TRUE(eve::all(barrett_reduce<curve_nist_p256::N>(t) ==
+    wide_bignum_set1<WBN>("66e12d94f3d956202845b2392b6bec594699799c49bd6fa683244c95be79eea1"_hex)));
+  EXPECT_TRUE(eve::all(barrett_reduce<curve_nist_p256::P>(t) ==
+    wide_bignum_set1<WBN>("00000004fffffffdfffffffffffffffefffffffbffffffff0000000000000002"_hex)));
+}
+
+TEST(Barrett, Gfp) {
+  using Pr = curve_nist_p256::N;
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  using GFP = GFp<WBN, Pr, wide_barrett_bignum<WBN, Pr>>;
+  using GFP_mgry = GFp<WBN, Pr>;
+  const auto a = GFP::from_classical(wide_bignum_set1<WBN>("b560fd7b259468b53c3a1623f35786a491fcb1fcdfbb0165da4dccce1f185b60"_hex));
+  EXPECT_TRUE(eve::all((a*a.inverse()).wbn() == GFP::one().wbn()));
+  EXPECT_TRUE(eve::all((a*a.template inverse<inversion_strategy::fermat>()).wbn() == GFP::one().wbn()));
+  EXPECT_TRUE(eve::all((a+a.opposite()).wbn() == eve::zero(eve::as(a.wbn()))));
+
+  const auto h = wide_bignum_set1<wbn_zext_t<WBN>>("f3b9cac2fc632551ffffffff00000000ffffffffffffffffbce6faada7179e84b560fd7b259468b53c3a1623f35786a491fcb1fcdfbb0165da4dccce1f185b60"_hex);
+  EXPECT_TRUE(eve::all(GFP::from_classical_wide(h).to_classical() == GFP_mgry::from_classical_wide(h).to_classical()));
+}
+
+template <uint64_t K, concepts::bignum_cst Pr, template <class, class> class MgryRepr>
+static void CheckMulSmall()
+{
+  using WBN = eve::wide<bn_t<Pr>, eve::fixed<4>>;
+  using WMBN = MgryRepr<WBN, Pr>;
+  using cbn_type = typename WBN::value_type::cbn_type;
+  check_fe_op<Pr, WBN, 1>([](auto const& v) { return mgry_mul_small<K>(WMBN::from_classical(v[0])).to_classical(); },
+    [](auto const& c) { return mul_mod_ref<Pr>(c[0], cbn_type{K}); });
+}
+
+template <concepts::bignum_cst Pr, template <class, class> class MgryRepr>
+static void TestMulSmall()
+{
+  CheckMulSmall<2, Pr, MgryRepr>();
+  CheckMulSmall<3, Pr, MgryRepr>();
+  CheckMulSmall<4, Pr, MgryRepr>();
+  CheckMulSmall<8, Pr, MgryRepr>();
+  CheckMulSmall<19, Pr, MgryRepr>();
+}
+
+TEST(MulSmall, Repr) {
+  TestMulSmall<curve_nist_p256::P, wide_field_bignum>();
+  TestMulSmall<curve_nist_p256::P, wide_mgry_bignum>();
+  TestMulSmall<curve_nist_p256::N, wide_barrett_bignum>();
+  TestMulSmall<P, wide_mgry_u32x64>();
+  TestMulSmall<P, wide_mgry_r29>();
+  TestMulSmall<P384, wide_field_bignum>();
+  TestMulSmall<P25519, wide_field_bignum>();
+  TestMulSmall<PGeneric, wide_mgry_bignum>();
+}
+
+// In the special form, where the numbers are stored as is: products whose
+// single correction is taken, and ones where it is not
+template <uint64_t K, concepts::bignum_cst Pr>
+static void CheckMulSmallKat(std::array<uint8_t, 32> const& a, std::array<uint8_t, 32> const& r)
+{
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  using WMBN = wide_special_bignum<WBN, Pr>;
+  EXPECT_TRUE(eve::all(mgry_mul_small<K>(WMBN{wide_bignum_set1<WBN>(a)}).wbn() == wide_bignum_set1<WBN>(r)));
+}
+
+TEST(MulSmall, Correction) {
+  using P256 = curve_nist_p256::P;
+  CheckMulSmallKat<3, P256>("5555555500000000555555555555555555555555aaaaaaaaaaaaaaaaaaaaaaab"_hex,
+    "0000000000000000000000000000000000000000000000000000000000000002"_hex);
+  CheckMulSmallKat<3, P256>("aaaaaaaa00000000aaaaaaaaaaaaaaaaaaaaaaab555555555555555555555555"_hex,
+    "0000000000000000000000000000000000000000000000000000000000000001"_hex);
+  CheckMulSmallKat<19, P256>("0d79435e435e50d7a1af286bca1af286bca1af2879435e50d79435e50d79435f"_hex,
+    "000000000000000000000000000000000000000000000000000000000000000e"_hex);
+  CheckMulSmallKat<19, P>("0d79435e50d79435e50d79435e50d79435e50d79435e50d79435e50d6bca1ac0"_hex,
+    "0000000000000000000000000000000000000000000000000000000000000011"_hex);
+
+  CheckMulSmallKat<3, P256>("ffffffff00000001000000000000000000000000fffffffffffffffffffffffe"_hex,
+    "ffffffff00000001000000000000000000000000fffffffffffffffffffffffc"_hex);
+  CheckMulSmallKat<3, P256>("a8b58bbe70e83bb4765d415f1073da4408c79f27102e9203ee5fce7743727a55"_hex,
+    "fa20a33c52b8b31c6317c41d315b8ecc1a56dd74308bb60bcb1f6b65ca576f00"_hex);
+}
+
+TEST(MulSmall, GfpLazy) {
+  using WBN = eve::wide<bignum_256, eve::fixed<8>>;
+  using GFP = GFp<WBN, P, wide_mgry_r52<WBN, P>>;
+  const auto a = GFP::from_classical(wide_bignum_set1<WBN>("b560fd7b259468b53c3a1623f35786a491fcb1fcdfbb0165da4dccce1f185b60"_hex));
+  const auto la = lazy(a);
+  EXPECT_TRUE(eve::all(GFP{gfp_mul_small<3>(la)}.wbn() == (gfp_shift_left<1>(a) + a).wbn()));
+  EXPECT_TRUE(eve::all(GFP{gfp_mul_small<8>(la + la)}.wbn() == gfp_shift_left<4>(a).wbn()));
+  EXPECT_TRUE(eve::all(gfp_mul_small<3>(a).wbn() == (gfp_shift_left<1>(a) + a).wbn()));
+}
+
+template <concepts::bignum_cst Pr, template <class, class> class MgryRepr>
+static void TestSumOfProducts()
+{
+  using BN = bn_t<Pr>;
+  using WBN = eve::wide<BN, eve::fixed<4>>;
+  using GFP = GFp<WBN, Pr, MgryRepr<WBN, Pr>>;
+  constexpr auto p = Pr::value.cbn();
+  const auto to_gfp = [](std::array<WBN, 4> const& v) {
+    std::array<GFP, 4> g;
+    for (size_t k = 0; k < v.size(); ++k) {
+      g[k] = GFP::from_classical(v[k]);
+    }
+    return g;
+  };
+
+  check_fe_op<Pr, WBN, 4>([&](auto const& v) {
+    const auto g = to_gfp(v);
+    return gfp_sum_of_products(mul_term(g[0], g[1]), -mul_term(g[2], g[3]), -add_term(g[0])).to_classical();
+  }, [&](auto const& c) {
+    return cbn::mod_sub(cbn::mod_sub(mul_mod_ref<Pr>(c[0], c[1]), mul_mod_ref<Pr>(c[2], c[3]), p), c[0], p);
+  });
+  check_fe_op<Pr, WBN, 4>([&](auto const& v) {
+    const auto g = to_gfp(v);
+    return gfp_sum_of_products(sqr_term(g[0]), -sqr_term(g[1]), add_term(g[2]), -add_term(g[3])).to_classical();
+  }, [&](auto const& c) {
+    return cbn::mod_sub(cbn::mod_add(cbn::mod_sub(mul_mod_ref<Pr>(c[0], c[0]), mul_mod_ref<Pr>(c[1], c[1]), p), c[2], p), c[3], p);
+  });
+}
+
+TEST(SumOfProducts, Repr) {
+  TestSumOfProducts<curve_nist_p256::P, wide_field_bignum>();
+  TestSumOfProducts<curve_nist_p256::P, wide_mgry_bignum>();
+  TestSumOfProducts<P, wide_field_bignum>();
+  TestSumOfProducts<P, wide_mgry_bignum>();
+  TestSumOfProducts<P, wide_mgry_r29>();
+  TestSumOfProducts<curve_nist_p256::N, wide_barrett_bignum>();
+  TestSumOfProducts<P384, wide_field_bignum>();
+  TestSumOfProducts<P25519, wide_field_bignum>();
+  TestSumOfProducts<PGeneric, wide_mgry_bignum>();
+}
+
+// The largest positive and negative sums, with p-1 = -1 in every term:
+// 1+1+(p-1) = p+1, 1+1+(p-1)+(p-1) = 2p, and 0-1-1-(p-1) = -(p+1). The first
+// term must be positive.
+template <class GFP>
+static void TestSumOfProductsExtremes()
+{
+  using WBN = typename GFP::WBN;
+  const auto m = GFP::from_classical(wide_bignum_set1<WBN>("ffffffff00000001000000000000000000000000fffffffffffffffffffffffe"_hex));
+  const auto one = wide_bignum_set1<WBN>("0000000000000000000000000000000000000000000000000000000000000001"_hex);
+  const auto zero = eve::zero(eve::as<WBN>());
+  const auto z = GFP::from_classical(zero);
+  EXPECT_TRUE(eve::all(gfp_sum_of_products(mul_term(m, m), sqr_term(m), add_term(m)).to_classical() == one));
+  EXPECT_TRUE(eve::all(gfp_sum_of_products(mul_term(m, m), sqr_term(m), add_term(m), add_term(m)).to_classical() == zero));
+  EXPECT_TRUE(eve::all(gfp_sum_of_products(add_term(z), -mul_term(m, m), -sqr_term(m), -add_term(m)).to_classical() == m.to_classical()));
+}
+
+TEST(SumOfProducts, Extremes) {
+  using Pr = curve_nist_p256::P;
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  TestSumOfProductsExtremes<GFp<WBN, Pr>>();
+  TestSumOfProductsExtremes<GFp<WBN, Pr, wide_mgry_bignum<WBN, Pr>>>();
+}
+
+TEST(SumOfProducts, GfpLazy) {
+  using WBN = eve::wide<bignum_256, eve::fixed<8>>;
+  using GFP = GFp<WBN, P, wide_mgry_r52<WBN, P>>;
+  const auto a = GFP::from_classical(wide_bignum_set1<WBN>("b560fd7b259468b53c3a1623f35786a491fcb1fcdfbb0165da4dccce1f185b60"_hex));
+  const auto b = GFP::from_classical(wide_bignum_set1<WBN>("6d9db3ef8aee9d6e3c1a4f4b0a3c28cbc0bb6c3e1ff3d3f0d0cc1b1e4b26bda7"_hex));
+  const auto la = lazy(a);
+  const auto lb = lazy(b);
+  const auto ref = a*b - b.sqr() - a;
+  EXPECT_TRUE(eve::all(GFP{gfp_sum_of_products(mul_term(la, lb), -sqr_term(lb), -add_term(la))}.wbn() == ref.wbn()));
+  EXPECT_TRUE(eve::all(gfp_sum_of_products(mul_term(a, b), -sqr_term(b), -add_term(a)).wbn() == ref.wbn()));
+}
+
+template <concepts::bignum_cst Pr>
+static void TestMgryFused()
+{
+  using WBN = eve::wide<bn_t<Pr>, eve::fixed<4>>;
+  using p_is = array_to_integer_sequence_t<special_form_constants<Pr>::p>;
+  const auto mont_ref = [](auto const& a, auto const& b) { return cbn::montgomery_mul(a, b, p_is{}); };
+
+  check_fe_op<Pr, WBN, 2>([](auto const& v) { return details::mgry_mul<Pr>(v[0], v[1]); },
+    [&](auto const& c) { return mont_ref(c[0], c[1]); }, 64);
+  check_fe_op<Pr, WBN, 1>([](auto const& v) { return details::mgry_sqr<Pr>(v[0]); },
+    [&](auto const& c) { return mont_ref(c[0], c[0]); }, 64);
+  check_fe_op<Pr, WBN, 1>([](auto const& v) { return details::mgry_sqr_n<Pr, 3>(v[0]); },
+    [&](auto const& c) {
+      auto ref = c[0];
+      for (size_t k = 0; k < 3; ++k) {
+        ref = mont_ref(ref, ref);
+      }
+      return ref;
+    }, 64);
+}
+
+TEST(Mgry, Fused) {
+  TestMgryFused<P>();
+  TestMgryFused<curve_nist_p256::P>();
+  TestMgryFused<P384>();
+  TestMgryFused<PGeneric>();
+}
+
+TEST(Mgry, FusedP256) {
+  // (p-1)*(p-1)/R == 1/R, R**2*1/R == R, and (p-1)**8/R**7 for three squarings
+  using Pr = curve_nist_p256::P;
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  const auto pm1 = wide_bignum_set1<WBN>("ffffffff00000001000000000000000000000000fffffffffffffffffffffffe"_hex);
+  const auto R2 = wide_bignum_set1<WBN>("00000004fffffffdfffffffffffffffefffffffbffffffff0000000000000003"_hex);
+  const auto one = wide_bignum_set1<WBN>("0000000000000000000000000000000000000000000000000000000000000001"_hex);
+  const auto Rinv = wide_bignum_set1<WBN>("fffffffe00000003fffffffd0000000200000001fffffffe0000000300000000"_hex);
+  EXPECT_TRUE(eve::all(details::mgry_mul<Pr>(pm1, pm1) == Rinv));
+  EXPECT_TRUE(eve::all(details::mgry_sqr<Pr>(pm1) == Rinv));
+  EXPECT_TRUE(eve::all(details::mgry_mul<Pr>(R2, one) == wide_bignum_set1<WBN>("00000000fffffffeffffffffffffffffffffffff000000000000000000000001"_hex)));
+  EXPECT_TRUE(eve::all(details::mgry_sqr_n<Pr, 3>(pm1) == wide_bignum_set1<WBN>("00009da4ffff4d52000065da0000933bffff3a760000fa1c00001b5dffff4d80"_hex)));
+}
+
+template <concepts::bignum_cst Pr>
+static void TestSafegcd()
+{
+  using WBN = eve::wide<bn_t<Pr>, eve::fixed<4>>;
+  constexpr auto p = Pr::value.cbn();
+
+  // The inverse of 0 is 0
+  check_fe_op<Pr, WBN, 1>([](auto const& v) { return safegcd_inverse<Pr>(v[0]); },
+    [](auto const& c) { return cbn::mod_inv(c[0], Pr::value.cbn()); });
+
+  // GFp requires p % 4 == 3 (see GFp::sqrt)
+  if constexpr ((p[0] & 3) == 3) {
+    using GFP = GFp<WBN, Pr>;
+    check_fe_op<Pr, WBN, 1>([](auto const& v) {
+        return GFP::from_classical(v[0]).template inverse<inversion_strategy::safegcd>().to_classical();
+      },
+      [](auto const& c) { return cbn::mod_inv(c[0], Pr::value.cbn()); });
+  }
+}
+
+TEST(Safegcd, Inverse) {
+  TestSafegcd<P>();
+  TestSafegcd<curve_nist_p256::P>();
+  TestSafegcd<P384>();
+  TestSafegcd<P25519>();
+}
+
+TEST(Safegcd, InverseP256) {
+  // Inverses of 1, p-1, 2 and 2**255
+  using Pr = curve_nist_p256::P;
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  constexpr std::array<uint8_t, 32> kats[][2] = {
+    {"0000000000000000000000000000000000000000000000000000000000000001"_hex,
+     "0000000000000000000000000000000000000000000000000000000000000001"_hex},
+    {"ffffffff00000001000000000000000000000000fffffffffffffffffffffffe"_hex,
+     "ffffffff00000001000000000000000000000000fffffffffffffffffffffffe"_hex},
+    {"0000000000000000000000000000000000000000000000000000000000000002"_hex,
+     "7fffffff80000000800000000000000000000000800000000000000000000000"_hex},
+    {"8000000000000000000000000000000000000000000000000000000000000000"_hex,
+     "fffffffd00000006fffffffa0000000400000002fffffffc0000000600000001"_hex},
+  };
+  for (auto const& [a, inv]: kats) {
+    EXPECT_TRUE(eve::all(safegcd_inverse<Pr>(wide_bignum_set1<WBN>(a)) == wide_bignum_set1<WBN>(inv)));
+  }
+}
+
+TEST(AddChain, P256) {
+  using Pr = curve_nist_p256::P;
+  using BN = bn_t<Pr>;
+  using WBN = eve::wide<BN, eve::fixed<4>>;
+  using GFP = GFp<WBN, Pr>;
+  using cbn_type = typename BN::cbn_type;
+  constexpr auto p = Pr::value.cbn();
+  const auto p_m2 = BN::from(cbn::subtract_ignore_carry(p, cbn_type{2}));
+  const auto p_sqrt = BN::from(cbn::detail::first<4>(cbn::shift_right(p+cbn_type{1}, 2)));
+  const auto p_euler = BN::from(cbn::shift_right(p, 1));
+
+  std::mt19937_64 rnd{0xac};
+
+  for (size_t n = 0; n < 16; ++n) {
+    const auto ga = GFP::from_classical(WBN{[&](auto i, auto _) { return random_fe<Pr>(rnd); }});
+    const auto inv = addition_chain<Pr>::inverse(ga);
+    const auto sqrt = addition_chain<Pr>::sqrt(ga);
+    EXPECT_TRUE(eve::all(inv.wbn() == mgry_pow(ga.wmbn(), p_m2).wbn()));
+    EXPECT_TRUE(eve::all(sqrt.wbn() == mgry_pow(ga.wmbn(), p_sqrt).wbn()));
+    EXPECT_TRUE(eve::all(addition_chain<Pr>::euler(ga).wbn() == mgry_pow(ga.wmbn(), p_euler).wbn()));
+  }
+}
+
+template <concepts::bignum_cst Pr>
+static void TestLegendre()
+{
+  using BN = bn_t<Pr>;
+  using WBN = eve::wide<BN, eve::fixed<8>>;
+  using cbn_type = typename BN::cbn_type;
+
+  check_fe_op<Pr, WBN, 1>([](auto const& v) { return GFp<WBN, Pr>::from_classical(v[0]).legendre(); },
+    [](auto const& c) {
+      constexpr auto p = Pr::value.cbn();
+      const auto p_m1 = cbn::subtract_ignore_carry(p, cbn_type{1});
+      const auto e = mod_exp_ref(c[0], cbn::shift_right(p_m1, 1), p);
+      return e == cbn_type{} ? int64_t{0} : (e == p_m1 ? int64_t{-1} : int64_t{1});
+    }, 4);
+}
+
+TEST(Mgry, Legendre) {
+  TestLegendre<P>();
+  TestLegendre<curve_nist_p256::P>();
+  TestLegendre<P384>();
+  TestLegendre<P25519>();
+}
+
+TEST(Mgry, SqrtLanes) {
+  using Pr = curve_nist_p256::P;
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  using GFP = GFp<WBN, Pr>;
+
+  // 3 is not a square mod p, so 3*b**2 is not either
+  const auto b = GFP::from_classical(WBN{[](auto i, auto _) {
+    auto v = bn_from_bytes_BE<bignum_256>("2714dac0b974321b75d6ef64e7c3b118adb2801bf674282df5712cd2af390f79"_hex).cbn();
+    v[0] += i;
+    return bignum_256::from(v);
+  }});
+  const auto three = GFP::from_classical(WBN{[](auto i, auto _) { return bignum_256::from(i == 2 ? 3 : 1); }});
+  const auto a = three * b.sqr();
+  EXPECT_EQ(a.legendre().get(2), -1);
+  EXPECT_FALSE(a.sqrt().has_value());
+
+  const auto [root, exists] = a.sqrt_lanes();
+  for (size_t i = 0; i < WBN::size(); ++i) {
+    EXPECT_EQ(exists.get(i), i != 2);
+    if (i != 2) {
+      EXPECT_EQ(root.sqr().wbn().get(i), a.wbn().get(i));
+    }
+  }
+
+  const auto [_, none] = (GFP::from_classical(WBN{bignum_256::from(3)}) * b.sqr()).sqrt_lanes();
+  EXPECT_FALSE(eve::any(none));
+}
+
+template <concepts::bignum_cst Pr, template <class, class> class MgryRepr, size_t W>
+static void TestPowWindow()
+{
+  using BN = bn_t<Pr>;
+  using WBN = eve::wide<BN, eve::fixed<4>>;
+  using WMBN = MgryRepr<WBN, Pr>;
+  using cbn_type = typename BN::cbn_type;
+  constexpr auto p = Pr::value.cbn();
+
+  // Per-lane exponents
+  check_fe_op<Pr, WBN, 2>([](auto const& v) { return mgry_pow_window<W>(WMBN::from_classical(v[0]), v[1]).to_classical(); },
+    [](auto const& c) { return mod_exp_ref(c[0], c[1], Pr::value.cbn()); }, 8);
+
+  // Exponents shared by all the lanes: 0, 1, p-2 and the ones whose windows
+  // are all ones
+  const cbn_type exps[] = {cbn_type{}, cbn_type{1}, cbn::subtract_ignore_carry(p, cbn_type{2}),
+    cbn::subtract_ignore_carry(cbn_type{}, cbn_type{1})};
+  for (auto const& e: exps) {
+    const auto ref = [&](auto const& c) { return mod_exp_ref(c[0], e, Pr::value.cbn()); };
+    check_fe_op<Pr, WBN, 1>([&](auto const& v) { return mgry_pow_window<W>(WMBN::from_classical(v[0]), BN::from(e)).to_classical(); }, ref, 2);
+    check_fe_op<Pr, WBN, 1>([&](auto const& v) { return mgry_pow_ladder(WMBN::from_classical(v[0]), BN::from(e)).to_classical(); }, ref, 2);
+  }
+}
+
+TEST(Mgry, PowWindow) {
+  using P256 = curve_nist_p256::P;
+  TestPowWindow<P256, wide_mgry_bignum, 4>();
+  TestPowWindow<P256, wide_mgry_bignum, 1>();
+  TestPowWindow<P256, wide_field_bignum, 5>();
+  TestPowWindow<P, wide_mgry_r29, 3>();
+}
+
+TEST(Mgry, PowWindowP256) {
+  // 2**(2**256-1), (p-1)**(2**256-1) and 3**(p-2)
+  using Pr = curve_nist_p256::P;
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  using WMBN = wide_mgry_bignum<WBN, Pr>;
+  constexpr std::array<uint8_t, 32> kats[][3] = {
+    {"0000000000000000000000000000000000000000000000000000000000000002"_hex,
+     "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"_hex,
+     "a178d7c2dfe5ffcfdefd5c58df98e83742da58d3c41fac47e1c198bfdb3edbc7"_hex},
+    {"ffffffff00000001000000000000000000000000fffffffffffffffffffffffe"_hex,
+     "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"_hex,
+     "ffffffff00000001000000000000000000000000fffffffffffffffffffffffe"_hex},
+    {"0000000000000000000000000000000000000000000000000000000000000003"_hex,
+     "ffffffff00000001000000000000000000000000fffffffffffffffffffffffd"_hex,
+     "aaaaaaaa00000000aaaaaaaaaaaaaaaaaaaaaaab555555555555555555555555"_hex},
+  };
+  for (auto const& [a, e, r]: kats) {
+    const auto wa = WMBN::from_classical(wide_bignum_set1<WBN>(a));
+    const auto we = wide_bignum_set1<WBN>(e);
+    const auto wr = wide_bignum_set1<WBN>(r);
+    EXPECT_TRUE(eve::all(mgry_pow_window<4>(wa, we).to_classical() == wr));
+    EXPECT_TRUE(eve::all(mgry_pow_window<5>(wa, we.get(0)).to_classical() == wr));
+    EXPECT_TRUE(eve::all(mgry_pow_ladder(wa, we.get(0)).to_classical() == wr));
+  }
+}
+
+TEST(GFn, P256) {
+  using Curve = curve_nist_p256;
+  using GFN = GFn<Curve, eve::fixed<4>>;
+  using WBN = typename GFN::WBN;
+  using WH = curve_wide_hash_t<Curve, eve::fixed<4>>;
+  using H = typename WH::value_type;
+  constexpr auto n = Curve::N::value.cbn();
+
+  std::mt19937_64 rnd{0x14};
+
+  for (size_t k = 0; k < 8; ++k) {
+    const WH h{[&](auto i, auto _) { return random_bn<H>(rnd); }};
+    const WBN a{[&](auto i, auto _) { return random_fe<Curve::N>(rnd); }};
+    const WBN b{[&](auto i, auto _) { return random_fe<Curve::N>(rnd); }};
+    const auto gh = GFN::from_classical_wide(h).to_classical();
+    const auto gab = (GFN::from_classical(a) * GFN::from_classical(b)).to_classical();
+    const auto ga = GFN::from_classical(a);
+    const auto inv = ga.inverse().to_classical();
+    const auto inv_fermat = ga.inverse<inversion_strategy::fermat>().to_classical();
+    for (size_t i = 0; i < WBN::size(); ++i) {
+      EXPECT_EQ(gh.get(i).cbn(), cbn::div(h.get(i).cbn(), n).remainder);
+      EXPECT_EQ(gab.get(i).cbn(), cbn::div(cbn::mul(a.get(i).cbn(), b.get(i).cbn()), n).remainder);
+      EXPECT_EQ(inv.get(i), inv_fermat.get(i));
+    }
+    EXPECT_TRUE(eve::all((ga*ga.inverse()).wbn() == GFN::one().wbn()));
+  }
+}
+
+TEST(MgryContext, Ops) {
+  using WBN = eve::wide<bignum_256, eve::fixed<4>>;
+  using BN = bignum_256;
+  using P256 = curve_nist_p256::P;
+
+  std::mt19937_64 rnd{0x15};
+
+  // One modulus per lane: P-256, an odd number of full size, and smaller ones
+  const WBN p{[&](auto i, auto _) {
+    if (i == 0) {
+      return P256::value;
+    }
+    auto v = random_bn<BN>(rnd).cbn();
+    v[0] |= 1;
+    if (i == 2) {
+      v[3] >>= 1;
+    }
+    else if (i == 3) {
+      v[3] = 0;
+      v[2] >>= 7;
+    }
+    return BN::from(v);
+  }};
+  const mgry_context<WBN> ctx{p};
+
+  for (size_t n = 0; n < 8; ++n) {
+    const WBN a{[&](auto i, auto _) { return random_bn_below(rnd, p.get(i)); }};
+    const WBN b{[&](auto i, auto _) { return random_bn_below(rnd, p.get(i)); }};
+    const WBN e{[&](auto i, auto _) { return random_bn<BN>(rnd); }};
+    const auto ma = ctx.from_classical(a);
+    const auto mb = ctx.from_classical(b);
+
+    EXPECT_TRUE(eve::all(ctx.to_classical(ma) == a));
+    const auto mul = ctx.to_classical(ctx.mul(ma, mb));
+    const auto sqr = ctx.to_classical(ctx.sqr(ma));
+    const auto sqr5 = ctx.sqr_n<5>(ma);
+    const auto add = ctx.to_classical(ctx.add(ma, mb));
+    const auto sub = ctx.to_classical(ctx.sub(ma, mb));
+    const auto pow_lanes = ctx.to_classical(ctx.pow(ma, e));
+    const auto pow = ctx.to_classical(ctx.pow(ma, e.get(0)));
+    for (size_t i = 0; i < WBN::size(); ++i) {
+      const auto ac = a.get(i).cbn();
+      const auto bc = b.get(i).cbn();
+      const auto pc = p.get(i).cbn();
+      EXPECT_EQ(mul.get(i).cbn(), cbn::div(cbn::mul(ac, bc), pc).remainder);
+      EXPECT_EQ(sqr.get(i).cbn(), cbn::div(cbn::mul(ac, ac), pc).remainder);
+      EXPECT_EQ(add.get(i).cbn(), cbn::mod_add(ac, bc, pc));
+      EXPECT_EQ(sub.get(i).cbn(), cbn::mod_sub(ac, bc, pc));
+      EXPECT_EQ(pow_lanes.get(i).cbn(), mod_exp_ref(ac, e.get(i).cbn(), pc));
+      EXPECT_EQ(pow.get(i).cbn(), mod_exp_ref(ac, e.get(0).cbn(), pc));
+    }
+    EXPECT_TRUE(eve::all(sqr5 == ctx.sqr(ctx.sqr(ctx.sqr(ctx.sqr(ctx.sqr(ma)))))));
+
+    // Same results as the compile-time path
+    using WMBN = wide_mgry_bignum<WBN, P256>;
+    const WBN a0{a.get(0)};
+    const WBN b0{b.get(0)};
+    const mgry_context<WBN> ctx256{WBN{P256::value}};
+    EXPECT_TRUE(eve::all(ctx256.mul(ctx256.from_classical(a0), ctx256.from_classical(b0)) ==
+      (WMBN::from_classical(a0) * WMBN::from_classical(b0)).wbn()));
+  }
+}
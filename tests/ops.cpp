@@ -1,6 +1,7 @@
 #include <ecsimd/add.h>
 #include <ecsimd/sub.h>
 #include <ecsimd/mul.h>
+#include <ecsimd/karatsuba.h>
 #include <ecsimd/cmp.h>
 #include <ecsimd/modular.h>
 #include <ecsimd/shift.h>
@@ -14,6 +15,8 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "tests.h"
 
 using namespace ecsimd;
@@ -250,3 +253,104 @@ TEST(Ops256, Mod) {
     EXPECT_TRUE(eve::all(res == wide_bignum_set1<WBN>("ffffffffffffffffffffffffffffffffffffffffffffffffffffffe1000003d1"_hex)));
   }
 }
+
+template <size_t Bits>
+static void TestMulKaratsuba()
+{
+  using BN = bignum<uint64_t, Bits/64>;
+  using WBN = wide_bignum<BN, eve::fixed<4>>;
+
+  using cbn_type = typename BN::cbn_type;
+
+  // The last lane carries as much as possible
+  std::mt19937_64 rnd{Bits};
+  const auto largest = BN::from(cbn::subtract_ignore_carry(cbn_type{}, cbn_type{1}));
+
+  for (size_t n = 0; n < 8; ++n) {
+    const WBN a{[&](auto i, auto _) { return i == 3 ? largest : random_bn<BN>(rnd); }};
+    const WBN b{[&](auto i, auto _) { return i == 3 ? largest : random_bn<BN>(rnd); }};
+    const auto mul = mul_karatsuba(a, b);
+    const auto sqr = sqr_karatsuba(a);
+    for (size_t i = 0; i < WBN::size(); ++i) {
+      const auto ac = a.get(i).cbn();
+      const auto bc = b.get(i).cbn();
+      EXPECT_EQ(mul.get(i).cbn(), cbn::mul(ac, bc));
+      EXPECT_EQ(sqr.get(i).cbn(), cbn::mul(ac, ac));
+    }
+  }
+}
+
+TEST(Ops, MulKaratsuba) {
+  TestMulKaratsuba<256>();
+  TestMulKaratsuba<1024>();
+  TestMulKaratsuba<2048>();
+  TestMulKaratsuba<4096>();
+}
+
+template <size_t Bits>
+static void TestSquare()
+{
+  using BN = bignum<uint64_t, Bits/64>;
+  using WBN = wide_bignum<BN, eve::fixed<4>>;
+  using cbn_type = typename BN::cbn_type;
+
+  // Products of the 32-bit digits 0xFFFFFFFF and 0x80000000 are just below
+  // 2**63, so that doubling them carries out of 64 bits.
+  std::mt19937_64 rnd{Bits+1};
+  cbn_type pattern;
+  for (size_t l = 0; l < pattern.size(); ++l) {
+    pattern[l] = l % 2 ? 0x80000000FFFFFFFF : 0xFFFFFFFF80000000;
+  }
+
+  for (size_t n = 0; n < 256; ++n) {
+    WBN a{[&](auto i, auto _) { return random_bn<BN>(rnd, test_digits::edge); }};
+    if (n == 0) {
+      a = WBN{BN::from(pattern)};
+    }
+    const auto sqr = square(a);
+    for (size_t i = 0; i < WBN::size(); ++i) {
+      const auto ac = a.get(i).cbn();
+      EXPECT_EQ(sqr.get(i).cbn(), cbn::mul(ac, ac));
+    }
+  }
+}
+
+TEST(Ops, Square) {
+  TestSquare<128>();
+  TestSquare<256>();
+  TestSquare<384>();
+  TestSquare<1024>();
+}
+
+template <size_t NLimbs>
+static void TestCarryLookahead()
+{
+  using BN = bignum<uint64_t, NLimbs>;
+  using WBN = wide_bignum<BN>;
+
+  // Limbs are often all zeros or all ones, so that carries propagate
+  std::mt19937_64 rnd{NLimbs};
+
+  for (size_t n = 0; n < 64; ++n) {
+    const WBN a{[&](auto i, auto _) { return random_bn<BN>(rnd, test_digits::edge); }};
+    const WBN b{[&](auto i, auto _) { return random_bn<BN>(rnd, test_digits::edge); }};
+
+    const auto [sum, carry] = add_lookahead(a, b);
+    const auto [sum_ref, carry_ref] = add_ripple(a, b);
+    EXPECT_TRUE(eve::all(sum == sum_ref));
+    EXPECT_TRUE(eve::all(carry == carry_ref));
+
+    const auto [diff, borrow] = sub_lookahead(a, b);
+    const auto [diff_ref, borrow_ref] = sub_ripple(a, b);
+    EXPECT_TRUE(eve::all(diff == diff_ref));
+    EXPECT_TRUE(eve::all(borrow == borrow_ref));
+  }
+}
+
+TEST(Ops, CarryLookahead) {
+  TestCarryLookahead<2>();
+  TestCarryLookahead<4>();
+  TestCarryLookahead<6>();
+  TestCarryLookahead<8>();
+  TestCarryLookahead<16>();
+}
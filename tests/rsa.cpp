@@ -0,0 +1,126 @@
+#include <ecsimd/rsa.h>
+#include <ecsimd/serialization.h>
+#include <ecsimd/literals.h>
+
+#include <ctbignum/division.hpp>
+#include <ctbignum/mult.hpp>
+#include <ctbignum/relational_ops.hpp>
+
+#include <eve/function/all.hpp>
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "tests.h"
+
+using namespace ecsimd;
+using namespace ecsimd::literals;
+
+namespace {
+
+template <size_t Bits>
+struct test_key {
+  std::array<uint8_t, Bits/8> n;
+  std::array<uint8_t, Bits/8> d;
+  std::array<uint8_t, Bits/16> p;
+  std::array<uint8_t, Bits/16> q;
+  std::array<uint8_t, Bits/16> dp;
+  std::array<uint8_t, Bits/16> dq;
+  std::array<uint8_t, Bits/16> qinv;
+};
+
+// Generated with openssl genrsa 2048
+constexpr test_key<2048> keys2048[] = {
+  {
+    "bfb9586d7a063f6872fc70e8a7f4eb06010f5c8c4a1d923b761f38b5eafc510b96c4c1f90a09894e4f3c1e9ab331a899f16ea386901b9af8c61e7474ca9786f2204e730561fe2b3b66d647bc06b0b1fa18f1cfef9164985814fac0dc50245f837732414758f1a501f7b238902d2050fd98b80ab914b61515958567dc99067cf1036493470664a8d419536b84ab50fa2934218d761c93be2ba327b15a6c7f932ef3f95847692a9bd8b0729c55ed4e041bea795189258b1882698402cde25e0236f5bd684ce7ea19170d2c1ae1f5820b068afc30b5c1ddf637c6843234d1f6b6e6d5beecfd06a747faa0d5bc81dc2122ca9c7b52fecd835416039474534affdf85"_hex,
+    "0493aba13d6afdc3840f33b0d2259e20b010ca504d0aa4ad87b5da1839aa5952f1fff3737b025c4542cdf81b10510ca9d42224843757795d1bf9a9250a9b106d22494d24a140bc8e77f78091e404fed2ae1ac3b07fe38b617aeabb84e6e2df66d7871b18d56e3b56af2f917b1ba0ac5e4971874c00cb11f8c86f7d59be4b71db126ee994bdde479715d51c427e3d1aa6615b03305fd61c8293cb80e584c7e53940a1d31ac76f7ef4ef30a4b281eae2c69cb363916c5e68edca877bcfda88b4bf77cd2b9f9670ca27c19713c93cacccbdd93bba1f3aadf6e42759ef736a31965c5aca72d57ea56324c57e9550370680ee069401be1ada9830acdd48c0c7075037"_hex,
+    "f2d4d0894a5dfd48c27a879388089827097c4c1b041a8a1fa1411d35b710f9850190fe0e9cea0ef09903b1b594f0a0e044a0981adcbbe6652ebe6408e80b137e153f8a9b9dd47812c0f0068e5207f6d22ec1eaadaae90c06883726e072e408bb9d47794bea2d5e3e4caf02d9a5c2381669d2df1dd84675a23109d5d930887fef"_hex,
+    "ca1f0454eff9ab1354327689b93bf714154f2da82954695c0dff029723a6b98c30931a6394a792cf0833f235e27c8711844d59541d25b5263c71f2fbe6adb38a8fb7a3ce919c71e238f41a2a7deaea74580aed1b057f94832ebdd16dcad2c611817a60797ae90d7684872293c8f2aeba7f1173738e1e2e5781632a35164763cb"_hex,
+    "3a183df7ca89e7f1c34d4b2839904cce720f81a9a8f6ac7adaba5841a495740ca50e4a29b6d2ac56555533ebcc41314bd63f518483b094733a96a41a1961a4fd321a2c900457738e91081b996af8aacd28108e9393e3035480bc2919e382b8b021f59a8855f31aabeeeea3d0ec3e25eafed04b3eb9a249bc4edd1a8346803193"_hex,
+    "1592b7f0a4e87e1503109bcc5964081c31a610d6790ad47009e2651162b1c1ee2fa513d4fb21e3ae8b4e98149e46f257b14a5c357922f431cf93cdfe8b01913f41d5b4fb3059856242f7f2ef041f95c4b33cff4fba0782ff7976b32ac7d23567daed07ed0f6c5e8e7ed8b99d127eac9da540649539df08cd38373063182ca87f"_hex,
+    "499e56b8d160810b8a64532a3858b20e594dc3b14e39f34bc1b61085986af2f0055d46079a2a60e90b2cc9449a5302a1befabb88b0d9d1bbdbbbf97fe6a2bd2b0567612e034d6f9ec0378ffde8b76e938b6e95ca46c1ebdaf2c07b869086068f137beefbf5b229ac43d10a0e9c2e4026f2a134bf9ae82af52d63460915572b5e"_hex,
+  },
+  {
+    "917118d7fcc2130a02eb1d89493465bd7499434084fb374d8362e3c923284efaa66f49814a82bd73ab27ad8112c53e85687720794e35cd88ee4c3a97c6d0e77f3d88b172342986a77054a5b8076bfa3e5b09367d70ea7217784576891ebd69462db5f3532a4b925c936a14e0300482e51cb422aa7d15e37ccfc02464baf87e24d6ea093c2f37f71a3b68509c12298dd760c09cb728a86a4e8eccf0b0841c487a4a3444347831a5d6a29a6ee598b14344baa3035b47ddd2486745792ce42ec09e2ef380a48c739aea3f6bb1b92d8f5481e65d44e9a730b2e64156b588d82c59f0e285e00f6284d359bfc3ed6d310ee9bf4d79c816a308f411990d59a1952373a7"_hex,
+    "03fceae6793ac514e0319c34b87a2454068f7145a29fd4cb5e4fe6d90c0abde7a78aa3a454ebb2d02a204364a7a41aebc38a88ac6ad594d62d5a8fbcbba9dcbf236bcd19c98e5defd767aac79a047eef18c5eee58fa40e0ed0b06ee8a19c25f7d3a70a8dfc39e8407b964c0e3da2d208003a7c3cda833022aafba4c3d2509ffcce06d1149b9e3e704eef2f5c02be654882a035d9157eab1b7322d606aa3fbed1273db4c68bf9cbcfa02121c570b149d69fe3e7db01eaabf27b8b0b967eaecedbd0b6b35f061bfb42bc821beb0c035faa36689ce044b48986e583e0fed0e0ef247ac36c371acefad85819e2e819cc898a68bf1cb745eb3aaaa13f63fe33222519"_hex,
+    "c1994f1424e72b2a0df8781f22210d7c513f00971468884eab70cff863f31bc180a2f2ac4201699dc982b39dbcbda0824fef001b0c99874ece0899b025544c956e8844eae7f222f249ac8fc777b0094b8411ed92756772df127bc0a1e3f2093134fe8d761a4cf4ec4d3f9875ca95abffc4fb3f8a04f535e4355edc5f625ebefd"_hex,
+    "c05222f23bc52d963b7859f4bb43e73998732768af47ead0b3067c88ca32feb8c773664b8f2d4622590e57e7a202603e40be9747630f08482a9d28350cbc512f6b4c05c5aee78f3ace73240f11210378c27abd5bd016252f10d40bbd3b355389fbe534e45ade4fa3051337c3963fc81589b3bf5763bd5435182cd1154e36c873"_hex,
+    "232dfdadb66aff6ffbebebc0148e9709c125c6b0ad77b5553e5818a2955f06eb29b9f28914d176e4c24a6ae33df9e361eaae8e815bcfc643aeb2e76297d5f2b8b0c63867cb5037c37959cf22bb00152050d6852a39055c5d66d9700ebb022f636eb2d6f7e01d9de016c578a9e6ef3dbb138b686767313be2c544009da09d80ed"_hex,
+    "17da17fb72ee417920670cc10d789e74c63381efb9cd7191f0a21d4fd9c3f95371691e86c07b1cf7a593e1d31884b2eb059c9da67ce2a06452e4aad7e97c71952ff97dbdc6b3715019caadee3071a7bc92622699fc74c2a7d3ae78c63f519dcabf32ee1c6428ae37c9a9588129613faf6c249ed677c8436952563c9827db2381"_hex,
+    "4b867ffaa9369ee3d091b1b91e4aa231cbd153807468cc0f15af10da5b863bcbe39513b4eedb7c43ca265e6b5d1f157dcc4ec51b10c1ed8c715327e48b971fe99cf06f53785d991c01c7596c5970c41516f566e7842b9e9ac2798bdbf21d7ea3af567b11d06c3e7bde7b53422ed4e6dcd46f7c51c0dfa4bb93d9bf6f03b1e2e7"_hex,
+  },
+};
+
+// Generated with openssl genrsa 4096
+constexpr test_key<4096> keys4096[] = {
+  {
+    "8b0ced160d2130b88b7c44d7a61392f05c44e030497d1da1545a73792852f3cb3dc7c39a3ca2b3ef49263082f5db77fb9ded5670a0215a00e21cd0619ddea2468b251aa873b49fa614bfa6d8db40a0ee0ce384d61e9f20d05c454ccfc9b1b2f7c7110ec3dc2e6fcaced3e25e9f68e6b37adaf5ec578b344f03f3efb1e416a81e89d9f3b7a6712d73e4120af89ce38bb889f5245824899019e8e37106f1478315b20609deca253db1d1c87353a46784affe3cb36fdec73a70d742f46dcb0ee70485d3bc3a8363f13ffed4a9e686377dac2d9372b52f5a347f3486c5c22bc7e07a3829eb8debdc70545f72987328f513b4d947e88890c3ad243d9cb93ac66e929d837ad62b6343da8447b23afbd79b43eaa99628f10b12530fa7eeb4071cffaceb3f2a5366fb9ec0d0e5eb445e838887e7689e203a664753c9e8247db8fd8ea755be5171d07c203911cf8331c70cd44c4c4d7ba5ae89b78575c8bafc0faf214ba40c7c57762987a0efce2c82131aaf6ca17cb6d7cf5aa526e0e956cab07f271415901653b626282ee859b47d200b8795f47acde62546b7be2a5b5de848ee0ffd1d3e2ec1d1533c73fba9039a953a4a855ae5663db83dd08a817222248b128a5d01da9b6512265f867a64203079e82bb9667d448485c88d7c3ff1ac1ce6c526c6048afdd68d0d3acbaf1423d50a56c78f032662279539fc9baf9c78cf8957dbd8c1"_hex,
+    "072cd9c7e4eb8ceddc232a130de10ab23e80a4f4ec1f79acf1b6605c3e597176b662d0ba862a14c415a2d3da6af4320fcc0971d4a3f84e35a77553fa9f270fad06371a22dabda25359d4bdeb22639ff7158460d7cfb5e798f8e056968e527482bd11f676e2e0be8ed92a93db99b90709c51e916284212694dad329cfd7f4a424a413328158f12dc0422f969024739576c01fb0d705f070e35bc888c12bf4f7541578a2b2f3c96bc5c64017883131d0b2ce991adee2c0a648c32946b8de1029ccd0f242b5ab0f3831ee31d2b9c9efa2b51e64259ef5dc5f29853cf653dbb3b14d7d3c0aefde10e4f6ff36ae69347872a27a34a31d5dbc97fa6ef7792d09da473adb452b29fd578a65e3cdc026fdf68c472b4ab0e3d74aae879d2c1ca919447d71c40ec8e4edc7f375cee1cba8f3265ab31921757045116dc4c0668c5cb61beedfcc921f899d7a04edf0fef18587fdd33bfc77dd7d0e818283dfd3e6791fb40b59f06d03ae64c3c6f51700eb18e9b4cc3921b211881b0ed27a7c218ad49a13a690875f8537b35b959ccc873ba16732d850f7d7e465b2957ecf02a7ecafd2fffb8528c500aba1ed682c4dc0ba32ffcb9580d923d577845335c5e3e066b9df7e8e4d325c1cb280cc2a3c75998729ca9b335a2a5d7d42b18eb08b9391241565c12e02a5efe71542154825bb851af26f911c43031336e53027733b83320d8053d1acf5"_hex,
+    "c1ee701efe33a5a8fbb55e3cca13be19710dc2cda8baa769fb31c64ea39070683d33684a25d83ac1a15a2548e2a32c0ec35974733de58c7667d9146e2c156c13d9150808ff75fb4a0748107d2b599aac945b9291ae25ca58a35f9afcd3982c120bc627001b60f3675458439465d950ba42ae98aa6c278e6612d2fb4a47604ddeebb20964ad8a3f0586e170729adbfc4f89d7ef0d949feb272be1dba53d6d2d012383bfdc2a9b064484666a850cfe54056407cc5a5c063ea9c625e89a38a95f925f8265e4a597636407bf89f3159df4b24c78c40c1c5827405dbb8569892532b413d91e60238c483ea7131b8294fc89cfedc32c12d98535efc12d500db7a4db8b"_hex,
+    "b78de136e2657a8eea83a405852b4d7cf4623b95d00961707eee2d1483da02669518f4daa72b3eff06f2854480337a0bdc883277b5f66766c6cb1a8f78df2781485cd1c797854111983b2e83e36003f422a191b7dc2d699dfd9240ea2db3bce7b237095e91e2a14b869763ad145c4c89af00b85741df0e46686a6c6b4817e01aab1c31e943ec7c249c59485f0b2f244b50f92819e092af51dccba8bc3d830e37c9c750f08e6d95029730af179c6ceecab704b555541debe4bfb883691721f0b8b90e8fa425a2776e00b8c46f19c1d667aa32c6d5d7c459bf4cf86a4d25b4f48a595df634d9426d785aaec3c4f197fb4df2a47ee0b1c79c07584eb34724571663"_hex,
+    "4457fb3b70ea529f52d57ff87c5ea8c7de87b2f7375750589125e175253f69ddd273a3753e110de3df311da2a9fc47328cb5a1cc5b2be26c77fc90aea2ea89c414e4cc881f3f3ce7c1d92bb670e88b11f6d6aeb8985ec908a3cab59c1415b4b24763f5aa9bfb76cc1b755f9b94a919420aedecef625e2e58da996fe5a571d2ff94a0919ee169aefc0ba4b7342c4f0a841d57f3ef1d499e5d97a168febabf16f527c6ee7e70a561781410e3c92fe31149350f6a7d0da145c41f088d088c9f6406f991c2c6e974889a6000a864fa614832edb041a6e2f64e1ee8e98502c44a4fac16b29579dc0d3c089868ab7141801e3120e17f4ec549a4d0718bbe82970d8a31"_hex,
+    "7ea533f90c67fc11d39914788293881968fcc623edb02b3cd5373c7f6521ec7a1ef1632fe21ba2918f97917fdbfca87ebaa07641c698c66b514a1d7f546493fb4d944d61ab17d3f771d3939a882d5d4cfb00036c9a4bf30d814181ec91afebece937b40d3e16e2371c1c2437ed4e69b8adb88f781508f3ee7c68c1799bfa6d33b94ff0d803778d882d202520feb47e14414047fce2c81293270695db9b8d6b27eedec8e7d13da68c6d08b826505590c4e956244f4584879802f82a233e44bab4996a848d3b3247b8ec628f96206d6fa382f919dbbdcdca2685d2f8755648ee58eea43815eab93c92c7eec1408778d779c6aadca7e7c1d3d3f5880786547a8a05"_hex,
+    "385fb64bde1c256272018ea8c33b15e46a8ac7496f291a695eeb6417df927345cc0c64fda769de22e8480076d486da9f1938162c28dc41f09259805905b1e6f237ea8a87b5145e1e201c46e094d838b33b05b29f6e5f0b95d06c1def4f434f416bf0efecd633a71f0ec5356698aa887c4dbe1846a1a0ef847067b6532b1143d08204053284b8290ae4bb4e926b87a62d42b2f9f2c073d05855d6823c1b9c53777ef2e6522e76555b4156a946ea7dd92c56183dbd162857d92df76257820254a5b9e5930288c43a57e67f3882d1d21347301f36ef6e2da33b4c1561aea751ace556c3ebb6a96ac19e4b17f72c9fa1cf92519735358cfa65c3cc1a0aa7b2c48bd3"_hex,
+  },
+};
+
+template <class T>
+T mod_exp_ref(T const& a, uint64_t e, T const& n)
+{
+  T ret{1};
+  for (size_t i = 64; i-- > 0;) {
+    ret = cbn::div(cbn::mul(ret, ret), n).remainder;
+    if ((e >> i) & 1) {
+      ret = cbn::div(cbn::mul(ret, a), n).remainder;
+    }
+  }
+  return ret;
+}
+
+} // anonymous
+
+// One key per lane
+template <size_t Bits, class Cardinal, size_t NKeys>
+static void TestPublicPrivate(test_key<Bits> const (&keys)[NKeys], size_t rounds)
+{
+  using RSA = wide_rsa<Bits, Cardinal>;
+  using WBN = typename RSA::WBN;
+  using WHBN = typename RSA::WHBN;
+  using BN = typename RSA::bignum_type;
+  using HBN = typename RSA::half_bignum_type;
+
+  auto key = [&](auto i) -> test_key<Bits> const& { return keys[i % NKeys]; };
+  const WBN n{[&](auto i, auto _) { return bn_from_bytes_BE<BN>(key(i).n); }};
+  const typename RSA::public_key pub{n};
+  const typename RSA::private_key priv{
+    WHBN{[&](auto i, auto _) { return bn_from_bytes_BE<HBN>(key(i).p); }},
+    WHBN{[&](auto i, auto _) { return bn_from_bytes_BE<HBN>(key(i).q); }},
+    WHBN{[&](auto i, auto _) { return bn_from_bytes_BE<HBN>(key(i).dp); }},
+    WHBN{[&](auto i, auto _) { return bn_from_bytes_BE<HBN>(key(i).dq); }},
+    WHBN{[&](auto i, auto _) { return bn_from_bytes_BE<HBN>(key(i).qinv); }}};
+
+  std::mt19937_64 rnd{0x16};
+  for (size_t k = 0; k < rounds; ++k) {
+    const WBN x{[&](auto i, auto _) { return random_bn_below(rnd, n.get(i)); }};
+
+    const auto y = pub.apply(x);
+    for (size_t i = 0; i < WBN::size(); ++i) {
+      EXPECT_EQ(y.get(i).cbn(), mod_exp_ref(x.get(i).cbn(), 65537, n.get(i).cbn()));
+    }
+    EXPECT_TRUE(eve::all(priv.apply(y) == x));
+    EXPECT_TRUE(eve::all(pub.apply(priv.apply(x)) == x));
+  }
+}
+
+TEST(RSA, PublicPrivate2048) {
+  TestPublicPrivate<2048, eve::fixed<4>>(keys2048, 4);
+}
+
+TEST(RSA, PublicPrivate2048x8) {
+  TestPublicPrivate<2048, eve::fixed<8>>(keys2048, 1);
+}
+
+TEST(RSA, PublicPrivate4096) {
+  TestPublicPrivate<4096, eve::fixed<4>>(keys4096, 1);
+}
@@ -3,7 +3,18 @@
 
 #include <ecsimd/bignum.h>
 #include <eve/wide.hpp>
+
+#include <gtest/gtest.h>
+
+#include <ctbignum/addition.hpp>
+#include <ctbignum/division.hpp>
+#include <ctbignum/mult.hpp>
+#include <ctbignum/relational_ops.hpp>
+
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <random>
 
 namespace ecsimd {
 
@@ -13,6 +24,127 @@ static auto wide_bignum_set1(std::array<uint8_t, sizeof(typename WBN::value_type
   return WBN{BN};
 }
 
+// Distribution of the limbs of random numbers
+enum class test_digits {
+  uniform,
+  // Limbs are zero, all ones, made of extreme 32-bit digits, or uniform. This
+  // hits carry corner cases (e.g. products of 32-bit digits just below 2**63)
+  // that uniform limbs only reach with a probability around 2**-31.
+  edge,
+};
+
+template <concepts::bignum BN>
+static BN random_bn(std::mt19937_64& rnd, test_digits digits = test_digits::uniform) {
+  constexpr uint64_t extremes[] = {0, 1, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF};
+  const auto digit = [&]() -> uint64_t {
+    const auto r = rnd() % (std::size(extremes)+1);
+    return r < std::size(extremes) ? extremes[r] : (rnd() & 0xFFFFFFFF);
+  };
+  typename BN::cbn_type v;
+  std::generate(std::begin(v), std::end(v), [&]() -> uint64_t {
+    if (digits == test_digits::uniform) {
+      return rnd();
+    }
+    switch (rnd() % 4) {
+      case 0: return 0;
+      case 1: return ~uint64_t{0};
+      case 2: return digit() | (digit() << 32);
+      default: return rnd();
+    }
+  });
+  return BN::from(v);
+}
+
+// Random number lower than m. With edge digits, numbers above m are reduced,
+// which only changes their most significant digits for moduli close to a
+// power of two.
+template <concepts::bignum BN>
+static BN random_bn_below(std::mt19937_64& rnd, BN const& m, test_digits digits = test_digits::uniform) {
+  const auto v = random_bn<BN>(rnd, digits).cbn();
+  if (digits == test_digits::edge && v < m.cbn()) {
+    return BN::from(v);
+  }
+  return BN::from(cbn::div(v, m.cbn()).remainder);
+}
+
+// Random element of GF(P), in classical form
+template <concepts::bignum_cst P>
+static auto random_fe(std::mt19937_64& rnd, test_digits digits = test_digits::uniform) {
+  return random_bn_below(rnd, P::value, digits);
+}
+
+// Lanes p-1, p-2, 0, 1, 2, ...: the largest and the smallest elements of
+// GF(P), in classical form
+template <concepts::bignum_cst P, concepts::wide_bignum WBN>
+static WBN edge_fe_lanes() {
+  using BN = typename WBN::value_type;
+  using cbn_type = typename BN::cbn_type;
+  constexpr auto p = P::value.cbn();
+  return WBN{[&](auto i, auto _) {
+    return i < 2 ? BN::from(cbn::subtract_ignore_carry(p, cbn_type{static_cast<uint64_t>(i+1)})) : BN::from(i-2);
+  }};
+}
+
+// Elements of GF(P) for the n-th iteration of a randomized test: the edge
+// lanes first, then random elements, half of them made of extreme digits
+template <concepts::bignum_cst P, concepts::wide_bignum WBN>
+static WBN random_fe_lanes(std::mt19937_64& rnd, size_t n) {
+  if (n == 0) {
+    return edge_fe_lanes<P, WBN>();
+  }
+  const auto digits = n % 2 ? test_digits::edge : test_digits::uniform;
+  return WBN{[&](auto i, auto _) { return random_fe<P>(rnd, digits); }};
+}
+
+// a*b % p
+template <concepts::bignum_cst P, class T>
+static auto mul_mod_ref(T const& a, T const& b) {
+  return cbn::div(cbn::mul(a, b), P::value.cbn()).remainder;
+}
+
+// a**e % p
+template <class T>
+static T mod_exp_ref(T const& a, T const& e, T const& p)
+{
+  T ret{1};
+  for (size_t i = e.size()*64; i-- > 0;) {
+    ret = cbn::div(cbn::mul(ret, ret), p).remainder;
+    if ((e[i/64] >> (i%64)) & 1) {
+      ret = cbn::div(cbn::mul(ret, a), p).remainder;
+    }
+  }
+  return ret;
+}
+
+// Checks an operation on N elements of GF(P) against a ctbignum reference,
+// on the edge lanes and on random elements: op maps the N wide numbers (in
+// classical form) to a wide number or a SIMD vector, and ref maps the N numbers
+// of each lane to the expected one.
+template <concepts::bignum_cst P, concepts::wide_bignum WBN, size_t N, class Op, class Ref>
+static void check_fe_op(Op const& op, Ref const& ref, size_t count = 32) {
+  using cbn_type = typename WBN::value_type::cbn_type;
+  std::mt19937_64 rnd{0xfe};
+  for (size_t n = 0; n < count; ++n) {
+    std::array<WBN, N> v;
+    for (auto& x: v) {
+      x = random_fe_lanes<P, WBN>(rnd, n);
+    }
+    const auto r = op(v);
+    for (size_t i = 0; i < WBN::size(); ++i) {
+      std::array<cbn_type, N> c;
+      for (size_t k = 0; k < N; ++k) {
+        c[k] = v[k].get(i).cbn();
+      }
+      if constexpr (requires { r.get(i).cbn(); }) {
+        EXPECT_EQ(r.get(i).cbn(), ref(c));
+      }
+      else {
+        EXPECT_EQ(r.get(i), ref(c));
+      }
+    }
+  }
+}
+
 } // ecsimd
 
 #endif